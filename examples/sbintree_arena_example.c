@@ -0,0 +1,52 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#define SBINTREE_IMPLEMENTATION
+#include "../sbintree.h"
+
+int int_comp(void *a, void *b)
+{
+    intptr_t x = (intptr_t) a;
+    intptr_t y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+int main()
+{
+    printf("%lu %lu\n", sizeof(sbintree_arena_node), sizeof(sbintree));
+    /* 32 48 */
+
+    sbintree_arena t = sbintree_arena_new();
+    sbintree_arena_reserve(&t, 100);
+
+    /* sorted input stays balanced */
+    for (intptr_t i = 0; i < 100; i++)
+    {
+        sbintree_arena_insert(&t, (void *) i, int_comp, NULL);
+    }
+
+    for (intptr_t i = 0; i < 100; i++)
+    {
+        if (i % 10 != 0)
+        {
+            sbintree_arena_remove(&t, sbintree_arena_search(&t, (void *) i, int_comp));
+        }
+    }
+
+    for (uint32_t node = sbintree_arena_first(&t); node != SBINTREE_ARENA_NIL; node = sbintree_arena_next(&t, node))
+    {
+        printf("%ld ", (long) (intptr_t) sbintree_arena_at(&t, node)->key);
+    }
+    printf("\n");
+    /* 0 10 20 30 40 50 60 70 80 90 */
+
+    /* removed nodes are reused before the arena grows */
+    sbintree_arena_insert(&t, (void *) 5, int_comp, NULL);
+    printf("%lu %u\n", t.length, t.used);
+    /* 11 100 */
+
+    /* all nodes are released at once */
+    sbintree_arena_free(&t);
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SBINTREE_IMPLEMENTATION
+#include "../sbintree.h"
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int key_comp(void *key, void *node_key)
+{
+    uintptr_t const a = (uintptr_t) key;
+    uintptr_t const b = (uintptr_t) node_key;
+    return (a > b) - (a < b);
+}
+
+static void node_free(sbintree * const node)
+{
+    free(node);
+}
+
+static size_t height(sbintree * const node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    size_t const left = height(node->left);
+    size_t const right = height(node->right);
+    return 1 + (left > right ? left : right);
+}
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void shuffle(uintptr_t * const keys, size_t const n)
+{
+    for (size_t i = n; i > 1; i--)
+    {
+        size_t const j = rng() % i;
+        uintptr_t const tmp = keys[i - 1];
+        keys[i - 1] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+static void run(char const * const name, uintptr_t * const keys, uintptr_t * const lookups, size_t const n)
+{
+    /* pointer-linked nodes from SBINTREE_MALLOC */
+    sbintree *root = NULL;
+    double start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        sbintree_insert(&root, (void *) keys[i], key_comp, NULL);
+    }
+    double const insert_time = now() - start;
+    size_t const tree_height = height(root);
+
+    start = now();
+    size_t found = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sbintree_search(root, (void *) lookups[i], key_comp) != NULL;
+    }
+    double const search_time = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        sbintree *node = sbintree_search(root, (void *) lookups[i], key_comp);
+        sbintree_remove(&root, node, node_free);
+    }
+    double const remove_time = now() - start;
+
+    /* arena nodes with 32-bit links */
+    sbintree_arena arena = sbintree_arena_new();
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        sbintree_arena_insert(&arena, (void *) keys[i], key_comp, NULL);
+    }
+    double const arena_insert_time = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sbintree_arena_search(&arena, (void *) lookups[i], key_comp) != SBINTREE_ARENA_NIL;
+    }
+    double const arena_search_time = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        sbintree_arena_remove(&arena, sbintree_arena_search(&arena, (void *) lookups[i], key_comp));
+    }
+    double const arena_remove_time = now() - start;
+    sbintree_arena_free(&arena);
+
+    printf("%-10s %6zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f%s\n", name, tree_height, n / insert_time * 1e-6,
+           n / search_time * 1e-6, n / remove_time * 1e-6, n / arena_insert_time * 1e-6, n / arena_search_time * 1e-6,
+           n / arena_remove_time * 1e-6, found == 2 * n ? "" : "  (lookup failed)");
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    uintptr_t *keys = (uintptr_t *) malloc(sizeof(uintptr_t) * n);
+    uintptr_t *lookups = (uintptr_t *) malloc(sizeof(uintptr_t) * n);
+    if (keys == NULL || lookups == NULL)
+    {
+        return 1;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        lookups[i] = i;
+    }
+    shuffle(lookups, n);
+
+    printf("%zu keys, millions of operations per second\n", n);
+    printf("%-10s %6s %10s %10s %10s %10s %10s %10s\n", "sequence", "height", "insert", "search", "remove",
+           "arena ins", "arena srch", "arena rem");
+
+    for (size_t i = 0; i < n; i++)
+    {
+        keys[i] = i;
+    }
+    run("sorted", keys, lookups, n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        keys[i] = n - 1 - i;
+    }
+    run("reverse", keys, lookups, n);
+
+    /* 0, n-1, 1, n-2, ... degenerates an unbalanced tree into a zigzag path */
+    for (size_t i = 0; i < n; i++)
+    {
+        keys[i] = i % 2 ? n - 1 - i / 2 : i / 2;
+    }
+    run("zigzag", keys, lookups, n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        keys[i] = i;
+    }
+    shuffle(keys, n);
+    run("random", keys, lookups, n);
+
+    free(keys);
+    free(lookups);
+
+    return 0;
+}
@@ -2,7 +2,6 @@
 #include <string.h>
 
 #define SBINTREE_IMPLEMENTATION
-#define SDLL_IMPLEMENTATION
 #include "../sbintree.h"
 
 int str_comp(void *s1, void *s2)
@@ -47,10 +46,31 @@ int main()
     sbintree *rightmost = sbintree_rightmost(root);
     printf("%s\n", (char *) (rightmost->data));
 
+    sbintree *floor = sbintree_floor(root, "bb", str_comp);
+    printf("%s\n", (char *) floor->key);
+
+    /* keys in the range [b, d) */
+    SBINTREE_FOREACH_RANGE(current, root, "b", "d", str_comp)
+    {
+        printf("%s ", (char *) current->key);
+    }
+    printf("\n");
+
     sbintree_remove(&root, node, sbintree_free_func);
-    sbintree_inorder(root, printf_callback);
+    SBINTREE_FOREACH(current, root)
+    {
+        printf("%s ", (char *) current->key);
+    }
+    printf("\n");
 
     sbintree_free(&root, sbintree_free_func);
 
+    /* balanced tree built from sorted keys in one allocation */
+    void *keys[] = {"f", "g", "h", "i", "j"};
+    sbintree *nodes = (sbintree *) malloc(sizeof(keys) / sizeof(keys[0]) * sizeof(sbintree));
+    root = sbintree_build_sorted(nodes, keys, keys, sizeof(keys) / sizeof(keys[0]));
+    printf("%s\n", (char *) root->key);
+    free(nodes);
+
     return 0;
 }
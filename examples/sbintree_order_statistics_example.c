@@ -0,0 +1,59 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#define SBINTREE_ORDER_STATISTICS
+#define SBINTREE_IMPLEMENTATION
+#include "../sbintree.h"
+
+int int_comp(void *a, void *b)
+{
+    intptr_t x = (intptr_t) a;
+    intptr_t y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+void sbintree_free_func(sbintree * const node)
+{
+    free(node);
+}
+
+/* value below which `percent` percent of the values fall */
+intptr_t percentile(sbintree * const root, size_t percent)
+{
+    size_t k = (sbintree_size(root) - 1) * percent / 100;
+    return (intptr_t) sbintree_select(root, k)->key;
+}
+
+int main()
+{
+    sbintree *latencies = NULL;
+
+    for (intptr_t i = 1; i <= 100; i++)
+    {
+        sbintree_insert(&latencies, (void *) (i * 10), int_comp, NULL);
+    }
+
+    printf("%ld %ld %ld\n", (long) percentile(latencies, 50), (long) percentile(latencies, 90),
+           (long) percentile(latencies, 99));
+    /* 500 900 990 */
+
+    /* drop the slowest half */
+    for (intptr_t i = 51; i <= 100; i++)
+    {
+        sbintree *node = sbintree_search(latencies, (void *) (i * 10), int_comp);
+        sbintree_remove(&latencies, node, sbintree_free_func);
+    }
+
+    printf("%ld\n", (long) percentile(latencies, 50));
+    /* 250 */
+
+    printf("%lu\n", sbintree_rank(latencies, (void *) 105, int_comp));
+    /* 10 */
+
+    printf("%lu\n", sbintree_count_range(latencies, (void *) 100, (void *) 200, int_comp));
+    /* 10 */
+
+    sbintree_free(&latencies, sbintree_free_func);
+
+    return 0;
+}
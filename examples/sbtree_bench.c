@@ -0,0 +1,157 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SBTREE_IMPLEMENTATION
+#include "../sbtree.h"
+
+#define SBINTREE_IMPLEMENTATION
+#include "../sbintree.h"
+
+#define RANGE_SCANS 10000
+#define RANGE_WIDTH 1000
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int key_comp(void *key, void *node_key)
+{
+    uintptr_t const a = (uintptr_t) key;
+    uintptr_t const b = (uintptr_t) node_key;
+    return (a > b) - (a < b);
+}
+
+/* a bijection on 64-bit integers, so the keys are unique and in random order
+ * without an array holding all of them */
+static uintptr_t key_at(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    /* leave room for the range bounds */
+    return (uintptr_t) (x >> 16);
+}
+
+static void count_callback(void *key, void *data, void *ctx)
+{
+    (void) key;
+    (void) data;
+    (*(size_t *) ctx)++;
+}
+
+static void node_free(sbintree * const node)
+{
+    free(node);
+}
+
+static void report(char const * const name, double const insert, double const search, double const iterate,
+                   double const ranges, size_t const n)
+{
+    printf("%-9s %12.2f %12.2f %12.1f %12.0f\n", name, n / insert * 1e-6, n / search * 1e-6, n / iterate * 1e-6,
+           RANGE_SCANS / ranges);
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    /* the binary tree needs about 50 bytes per key, skip it for huge runs */
+    bool const with_sbintree = argc > 2 ? atoi(argv[2]) != 0 : true;
+    /* lookups visit the keys in a different order than the inserts */
+    uint64_t const step = 0x9e3779b97f4a7c15ull;
+
+    printf("%zu random keys, inserts/searches/iteration in M keys/s, range scans of about %d keys in scans/s\n", n,
+           RANGE_WIDTH);
+    printf("%-9s %12s %12s %12s %12s\n", "", "insert", "search", "iterate", "range");
+
+    sbtree t = sbtree_new();
+    double start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        sbtree_insert(&t, (void *) key_at(i), key_comp, NULL);
+    }
+    double const insert = now() - start;
+
+    size_t found = 0;
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sbtree_search(&t, (void *) key_at(i * step % n), key_comp) != NULL;
+    }
+    double const search = now() - start;
+
+    uintptr_t checksum = 0;
+    start = now();
+    for (sbtree_iter it = sbtree_begin(&t); it.node != NULL; sbtree_next(&it))
+    {
+        checksum += (uintptr_t) sbtree_key(it);
+    }
+    double const iterate = now() - start;
+
+    /* the keys are spread over 48 bits, so this window holds about RANGE_WIDTH of them */
+    uintptr_t const window = ((uintptr_t) 1 << 48) / n * RANGE_WIDTH;
+    size_t visited = 0;
+    start = now();
+    for (size_t i = 0; i < RANGE_SCANS; i++)
+    {
+        uintptr_t const lo = key_at(i + n);
+        sbtree_range(&t, (void *) lo, (void *) (lo + window), key_comp, count_callback, &visited);
+    }
+    double const ranges = now() - start;
+    report("sbtree", insert, search, iterate, ranges, n);
+    sbtree_free(&t, sbtree_dummy_free);
+
+    if (with_sbintree)
+    {
+        sbintree *root = NULL;
+        start = now();
+        for (size_t i = 0; i < n; i++)
+        {
+            sbintree_insert(&root, (void *) key_at(i), key_comp, NULL);
+        }
+        double const bin_insert = now() - start;
+
+        start = now();
+        for (size_t i = 0; i < n; i++)
+        {
+            found += sbintree_search(root, (void *) key_at(i * step % n), key_comp) != NULL;
+        }
+        double const bin_search = now() - start;
+
+        start = now();
+        SBINTREE_FOREACH(node, root)
+        {
+            checksum -= (uintptr_t) node->key;
+        }
+        double const bin_iterate = now() - start;
+
+        start = now();
+        for (size_t i = 0; i < RANGE_SCANS; i++)
+        {
+            uintptr_t const lo = key_at(i + n);
+            SBINTREE_FOREACH_RANGE(node, root, (void *) lo, (void *) (lo + window), key_comp)
+            {
+                visited--;
+            }
+        }
+        double const bin_ranges = now() - start;
+        report("sbintree", bin_insert, bin_search, bin_iterate, bin_ranges, n);
+        sbintree_free(&root, node_free);
+
+        /* both trees must have seen the same keys */
+        if (found != 2 * n || checksum != 0 || visited != 0)
+        {
+            printf("mismatch between the trees\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#define SBTREE_IMPLEMENTATION
+#include "../sbtree.h"
+
+int int_comp(void *a, void *b)
+{
+    intptr_t x = (intptr_t) a;
+    intptr_t y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+void print_callback(void *key, void *data, void *ctx)
+{
+    (void) ctx;
+    printf("%ld: %s\n", (long) (intptr_t) key, (char *) data);
+}
+
+int main()
+{
+    sbtree t = sbtree_new();
+
+    /* sequential keys keep the tree shallow */
+    for (intptr_t i = 0; i < 1000; i++)
+    {
+        sbtree_insert(&t, (void *) i, int_comp, i % 2 == 0 ? "even" : "odd");
+    }
+    printf("%lu\n", t.length);
+    /* 1000 */
+
+    void **data = sbtree_search(&t, (void *) 42, int_comp);
+    printf("%s\n", (char *) *data);
+    /* even */
+
+    for (intptr_t i = 0; i < 1000; i++)
+    {
+        if (i % 100 != 0)
+        {
+            sbtree_remove(&t, (void *) i, int_comp, sbtree_dummy_free);
+        }
+    }
+
+    for (sbtree_iter it = sbtree_begin(&t); it.node != NULL; sbtree_next(&it))
+    {
+        printf("%ld ", (long) (intptr_t) sbtree_key(it));
+    }
+    printf("\n");
+    /* 0 100 200 300 400 500 600 700 800 900 */
+
+    /* keys in [250, 500) */
+    size_t visited = sbtree_range(&t, (void *) 250, (void *) 500, int_comp, print_callback, NULL);
+    printf("%lu\n", visited);
+    /*
+     * 300: even
+     * 400: even
+     * 2
+     */
+
+    sbtree_free(&t, sbtree_dummy_free);
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SCMAP_IMPLEMENTATION
+#include "../scmap.h"
+
+#define SBINTREE_IMPLEMENTATION
+#include "../sbintree.h"
+
+#define MAX_THREADS 32
+
+static size_t keys = 100000;
+static size_t ops = 2000000;
+static unsigned write_percent = 5;
+
+/* map under test */
+static scmap map;
+
+/* baseline: a red-black tree behind a reader-writer lock */
+static sbintree *root;
+static pthread_rwlock_t root_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int key_comp(void *key, void *node_key)
+{
+    uintptr_t const a = (uintptr_t) key;
+    uintptr_t const b = (uintptr_t) node_key;
+    return (a > b) - (a < b);
+}
+
+static void node_free(sbintree * const node)
+{
+    free(node);
+}
+
+static uint64_t rng(uint64_t * const state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void *scmap_worker(void *arg)
+{
+    uint64_t state = (uintptr_t) arg * 0x9e3779b97f4a7c15ull + 1;
+    size_t const reader = scmap_reader_register(&map);
+    size_t hits = 0;
+
+    for (size_t i = 0; i < ops; i++)
+    {
+        uint64_t const r = rng(&state);
+        void * const key = (void *) (uintptr_t) (r % keys);
+        if ((r >> 32) % 100 < write_percent)
+        {
+            if (r >> 63)
+            {
+                scmap_insert(&map, key, key_comp, NULL);
+            }
+            else
+            {
+                scmap_remove(&map, key, key_comp);
+            }
+        }
+        else
+        {
+            scmap_read_begin(&map, reader);
+            hits += scmap_get(&map, key, key_comp, NULL);
+            scmap_read_end(&map, reader);
+        }
+    }
+
+    scmap_reader_unregister(&map, reader);
+    return (void *) hits;
+}
+
+static void *rwlock_worker(void *arg)
+{
+    uint64_t state = (uintptr_t) arg * 0x9e3779b97f4a7c15ull + 1;
+    size_t hits = 0;
+
+    for (size_t i = 0; i < ops; i++)
+    {
+        uint64_t const r = rng(&state);
+        void * const key = (void *) (uintptr_t) (r % keys);
+        if ((r >> 32) % 100 < write_percent)
+        {
+            pthread_rwlock_wrlock(&root_lock);
+            if (r >> 63)
+            {
+                sbintree_insert(&root, key, key_comp, NULL);
+            }
+            else
+            {
+                sbintree *node = sbintree_search(root, key, key_comp);
+                if (node != NULL)
+                {
+                    sbintree_remove(&root, node, node_free);
+                }
+            }
+            pthread_rwlock_unlock(&root_lock);
+        }
+        else
+        {
+            pthread_rwlock_rdlock(&root_lock);
+            hits += sbintree_search(root, key, key_comp) != NULL;
+            pthread_rwlock_unlock(&root_lock);
+        }
+    }
+
+    return (void *) hits;
+}
+
+static double run(void *(*worker)(void *), int const threads)
+{
+    pthread_t ids[MAX_THREADS];
+    double const start = now();
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_create(&ids[i], NULL, worker, (void *) (uintptr_t) (i + 1));
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(ids[i], NULL);
+    }
+    return now() - start;
+}
+
+int main(int argc, char **argv)
+{
+    int const max_threads = argc > 1 ? atoi(argv[1]) : 4;
+    if (argc > 2)
+    {
+        write_percent = (unsigned) atoi(argv[2]);
+    }
+    if (argc > 3)
+    {
+        ops = strtoull(argv[3], NULL, 10);
+    }
+    if (max_threads < 1 || max_threads > MAX_THREADS)
+    {
+        return 1;
+    }
+
+    if (!scmap_init(&map, scmap_dummy_free))
+    {
+        return 1;
+    }
+    /* start with half of the keys present */
+    for (uintptr_t key = 0; key < keys; key += 2)
+    {
+        scmap_insert(&map, (void *) key, key_comp, NULL);
+        sbintree_insert(&root, (void *) key, key_comp, NULL);
+    }
+
+    printf("%zu keys, %u %% writes, %zu operations per thread, M operations/s\n", keys, write_percent, ops);
+    printf("%-8s %12s %12s\n", "threads", "scmap", "rwlock tree");
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        double const scmap_time = run(scmap_worker, threads);
+        double const rwlock_time = run(rwlock_worker, threads);
+        printf("%-8d %12.2f %12.2f\n", threads, ops * threads / scmap_time * 1e-6,
+               ops * threads / rwlock_time * 1e-6);
+    }
+
+    scmap_destroy(&map);
+    sbintree_free(&root, node_free);
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SCMAP_IMPLEMENTATION
+#include "../scmap.h"
+
+#define KEYS 1000
+#define READERS 3
+
+scmap map;
+atomic_bool done;
+
+int int_comp(void *a, void *b)
+{
+    intptr_t x = (intptr_t) a;
+    intptr_t y = (intptr_t) b;
+    return (x > y) - (x < y);
+}
+
+void *reader(void *arg)
+{
+    (void) arg;
+    size_t id = scmap_reader_register(&map);
+
+    while (!atomic_load(&done))
+    {
+        scmap_read_begin(&map, id);
+        for (intptr_t key = 0; key < KEYS; key++)
+        {
+            void *data;
+            if (scmap_get(&map, (void *) key, int_comp, &data) && (intptr_t) data != key * key)
+            {
+                printf("corrupted data of key %ld\n", (long) key);
+            }
+        }
+        scmap_read_end(&map, id);
+    }
+
+    scmap_reader_unregister(&map, id);
+    return NULL;
+}
+
+void count_callback(void *key, void *data, void *ctx)
+{
+    (void) key;
+    (void) data;
+    (*(size_t *) ctx)++;
+}
+
+int main()
+{
+    scmap_init(&map, scmap_dummy_free);
+
+    pthread_t readers[READERS];
+    for (int i = 0; i < READERS; i++)
+    {
+        pthread_create(&readers[i], NULL, reader, NULL);
+    }
+
+    /* the writer keeps changing the map while the readers search it */
+    for (int round = 0; round < 10; round++)
+    {
+        for (intptr_t key = 0; key < KEYS; key++)
+        {
+            scmap_insert(&map, (void *) key, int_comp, (void *) (key * key));
+        }
+        for (intptr_t key = 0; key < KEYS; key += 2)
+        {
+            scmap_remove(&map, (void *) key, int_comp);
+        }
+    }
+
+    atomic_store(&done, true);
+    for (int i = 0; i < READERS; i++)
+    {
+        pthread_join(readers[i], NULL);
+    }
+
+    size_t reader_id = scmap_reader_register(&map);
+    size_t count = 0;
+    scmap_read_begin(&map, reader_id);
+    scmap_range(&map, (void *) 100, (void *) 200, int_comp, count_callback, &count);
+    scmap_read_end(&map, reader_id);
+    printf("%lu %lu\n", map.length, count);
+    /* 500 50 */
+
+    scmap_destroy(&map);
+
+    return 0;
+}
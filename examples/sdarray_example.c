@@ -3,6 +3,12 @@
 #define SDARRAY_IMPLEMENTATION
 #include "../sdarray.h"
 
+bool is_odd(void *element, void *ctx)
+{
+    (void) ctx;
+    return *(int *) element % 2 != 0;
+}
+
 int main()
 {
     sdarray arr = sdarray_new(sizeof(char), 0);
@@ -36,7 +42,7 @@ int main()
 
     sdarray_remove(&arr3, 4);
     printf("%lu, %lu, %s\n", arr3.length, arr3.capacity, (char *) arr3.data);
-    /* 5, 5, foob */
+    /* 5, 11, foob */
 
     arr3.length--;
     sdarray_add_from(&arr3, "az", 3);
@@ -46,9 +52,43 @@ int main()
     printf("%c\n", *(char *) sdarray_at(&arr3, 3));
     /* b */
 
+    sdarray ints = sdarray_new(sizeof(int), 0);
+    for (int i = 0; i < 100; i++)
+    {
+        sdarray_push(&ints, &i);
+    }
+    printf("%lu, %lu\n", ints.length, ints.capacity);
+    /* 100, 137 */
+
+    /* the capacity is halved once the occupancy drops to a quarter */
+    int last;
+    while (ints.length > 20)
+    {
+        sdarray_pop(&ints, &last);
+    }
+    printf("%lu, %lu, %d\n", ints.length, ints.capacity, last);
+    /* 20, 68, 20 */
+
+    sdarray_shrink_to_fit(&ints);
+    printf("%lu, %lu\n", ints.length, ints.capacity);
+    /* 20, 20 */
+
+    int const head[] = {-3, -2, -1};
+    sdarray_insert_range(&ints, 0, head, 3);
+    sdarray_erase_range(&ints, 5, 10);
+    sdarray_swap_remove(&ints, 0);
+    sdarray_remove_if(&ints, is_odd, NULL);
+    for (size_t i = 0; i < ints.length; i++)
+    {
+        printf("%d ", *(int *) sdarray_at(&ints, i));
+    }
+    printf("\n");
+    /* -2 0 12 14 16 18 */
+
     free(arr.data);
     free(arr2.data);
     free(arr3.data);
+    free(ints.data);
 
     return 0;
 }
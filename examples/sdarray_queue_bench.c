@@ -0,0 +1,84 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static size_t realloc_count = 0;
+
+static void *counting_realloc(void *ptr, size_t size)
+{
+    realloc_count++;
+    return realloc(ptr, size);
+}
+
+#define SDARRAY_REALLOC(ptr, size) counting_realloc(ptr, size)
+#define SDARRAY_FREE(ptr) free(ptr)
+#define SDARRAY_IMPLEMENTATION
+#include "../sdarray.h"
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void report(char const * const name, size_t const ops, double const seconds)
+{
+    printf("%-12s %10.1f Mops/s %10zu reallocs\n", name, ops / seconds * 1e-6, realloc_count);
+    realloc_count = 0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 20000000;
+    size_t const burst = 4096;
+    sdarray arr = sdarray_new(sizeof(size_t), 0);
+    size_t value = 0;
+
+    /* producer pushes a burst, consumer drains it, e.g. a work stack */
+    realloc_count = 0;
+    double start = now();
+    for (size_t done = 0; done < n; done += burst)
+    {
+        for (size_t i = 0; i < burst; i++)
+        {
+            sdarray_push(&arr, &value);
+        }
+        while (sdarray_pop(&arr, &value))
+        {
+        }
+    }
+    report("burst", 2 * n, now() - start);
+
+    /* one push and one pop right around the shrink threshold */
+    for (size_t i = 0; i < 1025; i++)
+    {
+        sdarray_push(&arr, &value);
+    }
+    realloc_count = 0;
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        sdarray_pop(&arr, &value);
+        sdarray_push(&arr, &value);
+    }
+    report("oscillate", 2 * n, now() - start);
+
+    /* FIFO: keep a window of elements, consume from the front in batches */
+    realloc_count = 0;
+    start = now();
+    for (size_t done = 0; done < n; done += burst)
+    {
+        for (size_t i = 0; i < burst; i++)
+        {
+            sdarray_push(&arr, &value);
+        }
+        sdarray_erase_range(&arr, 0, burst);
+    }
+    report("fifo batches", 2 * n, now() - start);
+
+    free(arr.data);
+
+    return 0;
+}
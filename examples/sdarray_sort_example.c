@@ -0,0 +1,62 @@
+#include <stdio.h>
+
+#define SDARRAY_THREADS
+#define SDARRAY_IMPLEMENTATION
+#include "../sdarray.h"
+
+#define int_less(a, b) ((a) < (b))
+SDARRAY_DEFINE_SORT(int_sort, int, int_less)
+
+int int_cmp(const void *a, const void *b)
+{
+    int const x = *(const int *) a;
+    int const y = *(const int *) b;
+    return (x > y) - (x < y);
+}
+
+void print_ints(sdarray arr)
+{
+    for (size_t i = 0; i < arr.length; i++)
+    {
+        printf("%d ", *(int *) sdarray_at(&arr, i));
+    }
+    printf("\n");
+}
+
+int main()
+{
+    int const values[] = {5, -3, 8, 5, 0, -3, 12, 8, 1};
+    size_t const count = sizeof(values) / sizeof(values[0]);
+
+    sdarray arr = sdarray_new(sizeof(int), 0);
+    sdarray_add_from(&arr, values, count);
+    sdarray_radix_sort(&arr, SDARRAY_RADIX_I32);
+    print_ints(arr);
+    /* -3 -3 0 1 5 5 8 8 12 */
+
+    int const key = 5;
+    printf("%lu\n", sdarray_lower_bound(&arr, &key, int_cmp));
+    /* 4 */
+
+    sdarray_unique(&arr, int_cmp);
+    print_ints(arr);
+    /* -3 0 1 5 8 12 */
+
+    /* inlined comparator, no function pointer calls */
+    int ints[] = {5, -3, 8, 5, 0, -3, 12, 8, 1};
+    int_sort(ints, count);
+    printf("%d %d %lu\n", ints[0], ints[count - 1], int_sort_lower_bound(ints, count, 8));
+    /* -3 12 6 */
+
+    /* uses threads only for arrays above SDARRAY_PARALLEL_SORT_THRESHOLD */
+    sdarray arr2 = sdarray_new(sizeof(int), 0);
+    sdarray_add_from(&arr2, values, count);
+    sdarray_parallel_sort(&arr2, int_cmp, 4);
+    print_ints(arr2);
+    /* -3 -3 0 1 5 5 8 8 12 */
+
+    free(arr.data);
+    free(arr2.data);
+
+    return 0;
+}
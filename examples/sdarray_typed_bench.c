@@ -0,0 +1,64 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SDARRAY_IMPLEMENTATION
+#include "../sdarray.h"
+
+SDARRAY_DEFINE(int_array, int)
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 50000000;
+    long long sum = 0;
+
+    /* runtime-sized sdarray */
+    sdarray arr = sdarray_new(sizeof(int), 0);
+    double start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        int const value = (int) i;
+        sdarray_push(&arr, &value);
+    }
+    double const untyped_push = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < arr.length; i++)
+    {
+        sum += *(int *) sdarray_at(&arr, i);
+    }
+    double const untyped_iterate = now() - start;
+    free(arr.data);
+
+    /* typed array from SDARRAY_DEFINE */
+    int_array typed = int_array_new(0);
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        int_array_push(&typed, (int) i);
+    }
+    double const typed_push = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < typed.length; i++)
+    {
+        sum += typed.data[i];
+    }
+    double const typed_iterate = now() - start;
+    int_array_free(&typed);
+
+    printf("%zu ints (checksum %lld)\n", n, sum);
+    printf("%-10s %12s %12s\n", "", "push M/s", "iterate M/s");
+    printf("%-10s %12.1f %12.1f\n", "sdarray", n / untyped_push * 1e-6, n / untyped_iterate * 1e-6);
+    printf("%-10s %12.1f %12.1f\n", "typed", n / typed_push * 1e-6, n / typed_iterate * 1e-6);
+
+    return 0;
+}
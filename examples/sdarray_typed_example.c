@@ -0,0 +1,39 @@
+#include <stdio.h>
+
+#include "../sdarray.h"
+
+SDARRAY_DEFINE(int_array, int)
+
+int main()
+{
+    int_array arr = int_array_new(0);
+    printf("%lu, %lu\n", arr.length, arr.capacity);
+    /* 0, 0 */
+
+    for (int i = 0; i < 5; i++)
+    {
+        int_array_push(&arr, i * 10);
+    }
+    printf("%lu, %lu\n", arr.length, arr.capacity);
+    /* 5, 5 */
+
+    int_array_insert(&arr, 1, 5);
+    int_array_remove(&arr, 3);
+    for (size_t i = 0; i < arr.length; i++)
+    {
+        printf("%d ", arr.data[i]);
+    }
+    printf("\n");
+    /* 0 5 10 30 40 */
+
+    int last;
+    if (int_array_pop(&arr, &last))
+    {
+        printf("%d, %d\n", last, *int_array_at(&arr, 2));
+    }
+    /* 40, 10 */
+
+    int_array_free(&arr);
+
+    return 0;
+}
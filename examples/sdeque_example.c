@@ -0,0 +1,41 @@
+#include <stdio.h>
+
+#define SDARRAY_IMPLEMENTATION
+#define SDEQUE_IMPLEMENTATION
+#include "../sdeque.h"
+
+int main()
+{
+    sdeque dq = sdeque_new(sizeof(char), 8);
+    printf("%lu\n", dq.buf.capacity);
+    /* 8 */
+
+    sdeque_push_back_n(&dq, "world", 5);
+    sdeque_push_front(&dq, " ");
+    sdeque_push_front(&dq, "o");
+    sdeque_push_front(&dq, "l");
+
+    char c;
+    sdeque_pop_back(&dq, &c);
+    sdeque_push_back(&dq, "!");
+    printf("%lu, %c, %c\n", dq.length, *(char *) sdeque_at(&dq, 0), c);
+    /* 8, l, d */
+
+    /* the elements wrap around the end of the buffer */
+    void *first;
+    void *second;
+    size_t first_length;
+    size_t second_length;
+    sdeque_spans(&dq, &first, &first_length, &second, &second_length);
+    printf("%.*s|%.*s\n", (int) first_length, (char *) first, (int) second_length, (char *) second);
+    /* lo |worl! */
+
+    char buf[8];
+    size_t const n = sdeque_pop_front_n(&dq, buf, sizeof(buf));
+    printf("%.*s, %lu\n", (int) n, buf, dq.length);
+    /* lo worl!, 0 */
+
+    sdeque_free(&dq);
+
+    return 0;
+}
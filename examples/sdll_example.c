@@ -89,5 +89,33 @@ int main()
     /* free the entire list */
     sdll_free(&list, sdll_sstr_free);
 
+    /* lists bound to a pool take their nodes from shared slabs */
+    sdll_pool *pool = sdll_pool_new(1024);
+    sdll *pooled = sdll_new_pooled(pool);
+    int values[] = {1, 2, 3};
+    for (int i = 0; i < 3; i++)
+    {
+        sdll_insert_last(pooled, &values[i]);
+    }
+    /* the removed node goes back to the pool */
+    sdll_node *middle = pooled->first->next;
+    sdll_remove(pooled, &middle, sdll_dummy_free);
+    for (sdll_node *curr = pooled->first; curr != NULL; curr = curr->next)
+    {
+        printf("%d\n", *(int *) curr->data);
+    }
+
+    /* batch insert and O(1) concatenation of lists sharing the pool */
+    sdll *other = sdll_new_pooled(pool);
+    void *more[] = {&values[1], &values[0]};
+    sdll_insert_last_array(other, more, 2);
+    sdll_concat(pooled, other);
+    printf("%lu, %lu\n", pooled->length, other->length);
+
+    /* the nodes of a pooled list are released to the pool in O(1) */
+    sdll_free(&pooled, sdll_dummy_free);
+    sdll_free(&other, sdll_dummy_free);
+    sdll_pool_free(&pool);
+
     return 0;
 }
@@ -0,0 +1,45 @@
+#include <stdio.h>
+
+#define SDLL_IMPLEMENTATION
+#include "../sdll.h"
+
+typedef struct
+{
+    int key;
+    char const *value;
+    /* the list link lives inside the element, no allocation per insert */
+    sdll_link lru;
+} entry;
+
+int main()
+{
+    entry entries[] = {{1, "one", {NULL, NULL}}, {2, "two", {NULL, NULL}}, {3, "three", {NULL, NULL}}};
+
+    sdll_ilist lru;
+    sdll_ilist_init(&lru);
+    for (int i = 0; i < 3; i++)
+    {
+        sdll_ilist_insert_first(&lru, &entries[i].lru);
+    }
+
+    /* touch entry 1, moving it to the front */
+    sdll_ilist_unlink(&lru, &entries[0].lru);
+    sdll_ilist_insert_first(&lru, &entries[0].lru);
+
+    for (sdll_link *link = lru.first; link != NULL; link = link->next)
+    {
+        entry *e = SDLL_CONTAINER_OF(link, entry, lru);
+        printf("%d: %s\n", e->key, e->value);
+    }
+    /* 1: one
+     * 3: three
+     * 2: two */
+
+    /* evict the least recently used entry */
+    entry *evicted = SDLL_CONTAINER_OF(lru.last, entry, lru);
+    sdll_ilist_unlink(&lru, lru.last);
+    printf("%s, %lu\n", evicted->value, lru.length);
+    /* two, 2 */
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SDLL_IMPLEMENTATION
+#include "../sdll.h"
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run(char const * const name, sdll * const l, size_t const window, size_t const ops)
+{
+    for (size_t i = 0; i < window; i++)
+    {
+        sdll_insert_last(l, (void *) (uintptr_t) i);
+    }
+
+    /* churn: the oldest node is removed, a new one is inserted at either end,
+     * so the list order drifts away from the allocation order */
+    uint32_t seed = 1;
+    double start = now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        sdll_node *node = l->first;
+        sdll_remove(l, &node, sdll_dummy_free);
+        seed = seed * 1103515245 + 12345;
+        if (seed & 0x10000)
+        {
+            sdll_insert_last(l, (void *) (uintptr_t) i);
+        }
+        else
+        {
+            sdll_insert_first(l, (void *) (uintptr_t) i);
+        }
+    }
+    double const churn_time = now() - start;
+
+    int const rounds = 20;
+    uintptr_t sum = 0;
+    start = now();
+    for (int round = 0; round < rounds; round++)
+    {
+        for (sdll_node *node = l->first; node != NULL; node = node->next)
+        {
+            sum += (uintptr_t) node->data;
+        }
+    }
+    double const traverse_time = now() - start;
+
+    printf("%-8s churn %8.1f M ops/s  traversal %8.1f M nodes/s  (%lu)\n", name, ops / churn_time * 1e-6,
+           window * rounds / traverse_time * 1e-6, (unsigned long) sum);
+}
+
+int main(int argc, char **argv)
+{
+    size_t const window = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    size_t const ops = 10 * window;
+
+    sdll *l = sdll_new();
+    if (l == NULL)
+    {
+        return 1;
+    }
+    run("malloc", l, window, ops);
+    sdll_free(&l, sdll_dummy_free);
+
+    sdll_pool *pool = sdll_pool_new(4096);
+    sdll *pooled = pool == NULL ? NULL : sdll_new_pooled(pool);
+    if (pooled == NULL)
+    {
+        return 1;
+    }
+    run("pooled", pooled, window, ops);
+    sdll_free(&pooled, sdll_dummy_free);
+    sdll_pool_free(&pool);
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+
+#define SDARRAY_IMPLEMENTATION
+#define SFARRAY_IMPLEMENTATION
+#include "../sfarray.h"
+
+int main()
+{
+    char const *path = "sfarray_example.bin";
+    remove(path);
+
+    sfarray fa;
+    if (!sfarray_open(&fa, path, sizeof(double)))
+    {
+        return 1;
+    }
+
+    for (int i = 0; i < 1000; i++)
+    {
+        double const value = (i * 7919) % 1000 / 10.0;
+        sfarray_push(&fa, &value);
+    }
+
+    /* sort in place through an sdarray view */
+    sdarray view = sfarray_view(&fa);
+    sdarray_radix_sort(&view, SDARRAY_RADIX_F64);
+
+    sfarray_flush(&fa, true);
+    sfarray_close(&fa);
+
+    /* reopening only maps the file */
+    if (!sfarray_open(&fa, path, sizeof(double)))
+    {
+        return 1;
+    }
+    printf("%lu, %.1f, %.1f\n", fa.length, *(double *) sfarray_at(&fa, 0), *(double *) sfarray_at(&fa, fa.length - 1));
+    /* 1000, 0.0, 99.9 */
+
+    /* the element size is validated */
+    sfarray wrong;
+    printf("%d\n", sfarray_open(&wrong, path, sizeof(float)));
+    /* 0 */
+
+    sfarray_close(&fa);
+    remove(path);
+
+    return 0;
+}
@@ -3,7 +3,6 @@
 
 #define SHASHTAB_IMPLEMENTATION
 #define SBINTREE_IMPLEMENTATION
-#define SDLL_IMPLEMENTATION
 #include "../shashtab.h"
 
 int key_func(void *key, void *node_key)
@@ -25,29 +24,37 @@ int main()
         return 1;
     }
 
+    /* a per-table seed, use a random one for keys from untrusted input */
+    tab.seed = 0x9e3779b97f4a7c15ull;
+
     char *str = "Hello world";
 
-    if (!shashtab_set(tab, "foo", 4, key_func, str))
+    if (!shashtab_set(&tab, "foo", 4, key_func, str))
     {
         return 1;
     }
 
-    char *res = shashtab_get(tab, "foo", 4, key_func);
+    char *res = shashtab_get(&tab, "foo", 4, key_func);
     printf("foo: %s\n", res);
 
-    if (!shashtab_get(tab, "bar", 4, key_func))
+    /* reuse a hash which was already computed */
+    uint64_t hash = tab.hash_func("foo", 4, tab.seed);
+    res = shashtab_get_prehashed(&tab, hash, "foo", 4, key_func);
+    printf("foo (prehashed): %s\n", res);
+
+    if (!shashtab_get(&tab, "bar", 4, key_func))
     {
         printf("key 'bar' not found\n");
     }
 
-    shashtab_del(tab, "foo", 4, key_func, sbintree_free_func);
-    if (!shashtab_get(tab, "foo", 4, key_func))
+    shashtab_del(&tab, "foo", 4, key_func, sbintree_free_func);
+    if (!shashtab_get(&tab, "foo", 4, key_func))
     {
         printf("key 'foo' not found\n");
     }
 
     /* cleanup */
-    shashtab_free(tab, sbintree_free_func);
+    shashtab_free(&tab, sbintree_free_func);
 
     return 0;
 }
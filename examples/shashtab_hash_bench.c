@@ -0,0 +1,205 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SHASHTAB_IMPLEMENTATION
+#define SBINTREE_IMPLEMENTATION
+#include "../shashtab.h"
+
+/* bytes hashed for every key length in the throughput test */
+#define THROUGHPUT_BYTES (256u << 20)
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* the hash shashtab used before, one byte per iteration with a 32-bit state */
+static uint64_t fnv_1a_32(void const * const key, size_t const key_len, uint64_t const seed)
+{
+    (void) seed;
+    unsigned char const *bp = (unsigned char const *) key;
+    unsigned char const * const be = bp + key_len;
+
+    uint32_t hash = 0x811c9dc5;
+    while (bp < be)
+    {
+        hash ^= (uint32_t) *bp++;
+        hash += (hash << 1) + (hash << 4) + (hash << 7) + (hash << 8) + (hash << 24);
+    }
+
+    return hash;
+}
+
+static size_t next_prime(size_t n)
+{
+    for (;; n++)
+    {
+        bool prime = n > 1;
+        for (size_t d = 2; d * d <= n && prime; d++)
+        {
+            prime = n % d != 0;
+        }
+        if (prime)
+        {
+            return n;
+        }
+    }
+}
+
+static int hash_comp(void const *a, void const *b)
+{
+    uint64_t const x = *(uint64_t const *) a;
+    uint64_t const y = *(uint64_t const *) b;
+    return (x > y) - (x < y);
+}
+
+typedef uint64_t (*hash_fn)(void const *key, size_t key_len, uint64_t seed);
+
+static void throughput(char const * const name, hash_fn const hash, uint8_t const * const buf, size_t const buf_len)
+{
+    size_t const lengths[] = {4, 8, 16, 32, 64, 256, 4096};
+
+    printf("%-9s", name);
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+        size_t const len = lengths[l];
+        size_t const count = THROUGHPUT_BYTES / len;
+        uint64_t sink = 0;
+        double const start = now();
+        for (size_t i = 0; i < count; i++)
+        {
+            /* a different offset for every key, so the hash cannot be hoisted */
+            sink ^= hash(buf + (i * 61) % (buf_len - len), len, 0);
+        }
+        double const time = now() - start;
+        printf(" %9.2f", count * len / time * 1e-9);
+        /* keep the loop from being optimized away */
+        if (sink == 42)
+        {
+            printf("!");
+        }
+    }
+    printf("\n");
+}
+
+/* `key` fills `buf` with the i-th key of a set and returns its length */
+static void quality(char const * const set, size_t (*key)(size_t i, uint8_t *buf), size_t const n,
+                    uint32_t * const counts, uint64_t * const hashes)
+{
+    /* power-of-two buckets about as many as keys, like a full shashtab */
+    size_t mask = 1;
+    while (mask < n)
+    {
+        mask <<= 1;
+    }
+    mask--;
+    size_t const prime = next_prime(n);
+
+    struct
+    {
+        char const *name;
+        hash_fn hash;
+        bool modulo;
+    } const variants[] = {
+        {"fnv-1a % prime", fnv_1a_32, true},
+        {"fnv-1a & mask", fnv_1a_32, false},
+        {"shashtab & mask", shashtab_hash, false},
+    };
+
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++)
+    {
+        size_t const buckets = variants[v].modulo ? prime : mask + 1;
+        memset(counts, 0, buckets * sizeof(uint32_t));
+
+        uint8_t buf[64];
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t const len = key(i, buf);
+            hashes[i] = variants[v].hash(buf, len, 0);
+            counts[variants[v].modulo ? hashes[i] % prime : hashes[i] & mask]++;
+        }
+
+        /* pairs of keys sharing a bucket, relative to a uniformly random hash */
+        double pairs = 0;
+        for (size_t b = 0; b < buckets; b++)
+        {
+            pairs += (double) counts[b] * ((double) counts[b] - 1) / 2;
+        }
+        double const expected = (double) n * (n - 1) / 2 / buckets;
+
+        /* keys with the same full hash, which a stored hash cannot tell apart */
+        qsort(hashes, n, sizeof(uint64_t), hash_comp);
+        size_t equal = 0;
+        for (size_t i = 1; i < n; i++)
+        {
+            equal += hashes[i] == hashes[i - 1];
+        }
+
+        printf("%-12s %-16s %10zu %12.3f %12zu\n", set, variants[v].name, buckets, pairs / expected, equal);
+    }
+}
+
+static size_t key_integer(size_t const i, uint8_t * const buf)
+{
+    uint64_t const k = i;
+    memcpy(buf, &k, sizeof(k));
+    return sizeof(k);
+}
+
+/* integers which differ only in the high bits */
+static size_t key_shifted(size_t const i, uint8_t * const buf)
+{
+    uint64_t const k = (uint64_t) i << 32;
+    memcpy(buf, &k, sizeof(k));
+    return sizeof(k);
+}
+
+static size_t key_string(size_t const i, uint8_t * const buf)
+{
+    return (size_t) snprintf((char *) buf, 64, "user:%zu:name", i);
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+
+    size_t const buf_len = 1 << 20;
+    uint8_t *buf = (uint8_t *) malloc(buf_len);
+    uint32_t *counts = (uint32_t *) malloc(2 * n * sizeof(uint32_t) + 64);
+    uint64_t *hashes = (uint64_t *) malloc(n * sizeof(uint64_t));
+    if (buf == NULL || counts == NULL || hashes == NULL || n < 2)
+    {
+        return 1;
+    }
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < buf_len; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        buf[i] = (uint8_t) state;
+    }
+
+    printf("throughput in GB/s by key length in bytes\n");
+    printf("%-9s %9s %9s %9s %9s %9s %9s %9s\n", "", "4", "8", "16", "32", "64", "256", "4096");
+    throughput("fnv-1a", fnv_1a_32, buf, buf_len);
+    throughput("shashtab", shashtab_hash, buf, buf_len);
+
+    printf("\n%zu keys, bucket pairs relative to a random hash (1.0 is ideal) and equal full hashes\n", n);
+    printf("%-12s %-16s %10s %12s %12s\n", "keys", "hash", "buckets", "pairs", "equal");
+    quality("integers", key_integer, n, counts, hashes);
+    quality("high bits", key_shifted, n, counts, hashes);
+    quality("strings", key_string, n, counts, hashes);
+
+    free(buf);
+    free(counts);
+    free(hashes);
+
+    return 0;
+}
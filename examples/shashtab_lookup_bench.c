@@ -0,0 +1,131 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SHASHTAB_IMPLEMENTATION
+#define SBINTREE_IMPLEMENTATION
+#include "../shashtab.h"
+
+/* keys are `key_len` digits, the first n are inserted, the next n are misses */
+static size_t key_len;
+static char *keys;
+static size_t key_func_calls;
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int key_comp(void *key, void *node_key)
+{
+    key_func_calls++;
+    return memcmp(key, node_key, key_len);
+}
+
+static void node_free(sbintree * const node)
+{
+    free(node);
+}
+
+static char *key(size_t const i)
+{
+    return keys + i * key_len;
+}
+
+static uint64_t rng(uint64_t * const state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void report(char const * const name, double const time, size_t const found, size_t const n)
+{
+    printf("%-5zu %-14s %10.2f %10.3f %10zu\n", key_len, name, n / time * 1e-6, (double) key_func_calls / n, found);
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    unsigned const miss_percent = argc > 2 ? (unsigned) atoi(argv[2]) : 90;
+    /* a key which fits into the inline copy and one which does not */
+    size_t const lengths[] = {8, 32};
+
+    size_t *queries = (size_t *) malloc(n * sizeof(size_t));
+    uint64_t *hashes = (uint64_t *) malloc(n * sizeof(uint64_t));
+    if (queries == NULL || hashes == NULL)
+    {
+        return 1;
+    }
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t const r = rng(&state);
+        queries[i] = (r >> 32) % 100 < miss_percent ? n + r % n : r % n;
+    }
+
+    printf("%zu keys, %u %% misses, M lookups/s and key_func calls per lookup\n", n, miss_percent);
+    printf("%-5s %-14s %10s %10s %10s\n", "bytes", "lookup", "M/s", "key_func", "found");
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+        key_len = lengths[l];
+        keys = (char *) malloc(2 * n * key_len);
+        if (keys == NULL)
+        {
+            return 1;
+        }
+        char buf[64];
+        for (size_t i = 0; i < 2 * n; i++)
+        {
+            snprintf(buf, sizeof(buf), "%0*zu", (int) key_len, i);
+            memcpy(key(i), buf, key_len);
+        }
+
+        shashtab ht = shashtab_new(n);
+        if (ht.capacity == 0)
+        {
+            return 1;
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            shashtab_set(&ht, key(i), key_len, key_comp, key(i));
+        }
+
+        size_t found = 0;
+        key_func_calls = 0;
+        double start = now();
+        for (size_t i = 0; i < n; i++)
+        {
+            found += shashtab_get(&ht, key(queries[i]), key_len, key_comp) != NULL;
+        }
+        report("get", now() - start, found, n);
+
+        /* the hashes come from elsewhere, e.g. an earlier lookup of the same key */
+        for (size_t i = 0; i < n; i++)
+        {
+            hashes[i] = ht.hash_func(key(queries[i]), key_len, ht.seed);
+        }
+        found = 0;
+        key_func_calls = 0;
+        start = now();
+        for (size_t i = 0; i < n; i++)
+        {
+            found += shashtab_get_prehashed(&ht, hashes[i], key(queries[i]), key_len, key_comp) != NULL;
+        }
+        report("get_prehashed", now() - start, found, n);
+
+        shashtab_free(&ht, node_free);
+        free(keys);
+    }
+
+    free(queries);
+    free(hashes);
+
+    return 0;
+}
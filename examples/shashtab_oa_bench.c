@@ -0,0 +1,172 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SHASHTAB_IMPLEMENTATION
+#define SBINTREE_IMPLEMENTATION
+#include "../shashtab.h"
+
+/* keys are `key_len` digits, the first n are inserted, the next n are misses */
+static size_t key_len;
+static char *keys;
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int key_comp(void *key, void *node_key)
+{
+    return memcmp(key, node_key, key_len);
+}
+
+static void node_free(sbintree * const node)
+{
+    free(node);
+}
+
+static char *key(size_t const i)
+{
+    return keys + i * key_len;
+}
+
+static void make_keys(size_t const n)
+{
+    char buf[64];
+    for (size_t i = 0; i < 2 * n; i++)
+    {
+        snprintf(buf, sizeof(buf), "%0*zu", (int) key_len, i);
+        memcpy(key(i), buf, key_len);
+    }
+}
+
+static void report(char const * const name, double const insert, double const hit, double const miss,
+                   double const del, size_t const n)
+{
+    printf("%-5zu %-9s %10.2f %10.2f %10.2f %10.2f\n", key_len, name, n / insert * 1e-6, n / hit * 1e-6,
+           n / miss * 1e-6, n / del * 1e-6);
+}
+
+static size_t run_chained(size_t const n, uint64_t const step)
+{
+    size_t found = 0;
+    shashtab ht = shashtab_new(16);
+    if (ht.capacity == 0)
+    {
+        exit(1);
+    }
+
+    double start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        shashtab_set(&ht, key(i), key_len, key_comp, key(i));
+    }
+    double const insert = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += shashtab_get(&ht, key(i * step % n), key_len, key_comp) != NULL;
+    }
+    double const hit = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += shashtab_get(&ht, key(n + i), key_len, key_comp) != NULL;
+    }
+    double const miss = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        shashtab_del(&ht, key(i * step % n), key_len, key_comp, node_free);
+    }
+    double const del = now() - start;
+
+    report("chained", insert, hit, miss, del, n);
+    shashtab_free(&ht, node_free);
+    return found;
+}
+
+static size_t run_oa(size_t const n, uint64_t const step)
+{
+    size_t found = 0;
+    shashtab_oa ht = shashtab_oa_new(16);
+    if (ht.capacity == 0)
+    {
+        exit(1);
+    }
+
+    double start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        shashtab_oa_set(&ht, key(i), key_len, key_comp, key(i));
+    }
+    double const insert = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += shashtab_oa_get(&ht, key(i * step % n), key_len, key_comp) != NULL;
+    }
+    double const hit = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += shashtab_oa_get(&ht, key(n + i), key_len, key_comp) != NULL;
+    }
+    double const miss = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < n; i++)
+    {
+        shashtab_oa_del(&ht, key(i * step % n), key_len, key_comp);
+    }
+    double const del = now() - start;
+
+    report("oa", insert, hit, miss, del, n);
+    shashtab_oa_free(&ht);
+    return found;
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    /* lookups and deletes visit the keys in a different order than the inserts */
+    uint64_t const step = 0x9e3779b97f4a7c15ull;
+    /* a key which fits into the inline copy and one which does not */
+    size_t const lengths[] = {8, 32};
+
+    printf("%zu keys, M operations/s\n", n);
+    printf("%-5s %-9s %10s %10s %10s %10s\n", "bytes", "table", "insert", "hit", "miss", "delete");
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+        key_len = lengths[l];
+        keys = (char *) malloc(2 * n * key_len);
+        if (keys == NULL)
+        {
+            return 1;
+        }
+        make_keys(n);
+
+        size_t const chained_found = run_chained(n, step);
+        size_t const oa_found = run_oa(n, step);
+        free(keys);
+
+        /* both tables must find the same keys */
+        if (chained_found != oa_found)
+        {
+            printf("mismatch between the tables\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
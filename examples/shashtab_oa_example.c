@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <string.h>
+
+#define SHASHTAB_IMPLEMENTATION
+#define SBINTREE_IMPLEMENTATION
+#include "../shashtab.h"
+
+int key_func(void *key, void *node_key)
+{
+    return strcmp(key, node_key);
+}
+
+int main()
+{
+    shashtab_oa tab = shashtab_oa_new(4);
+
+    if (tab.capacity <= 0)
+    {
+        return 1;
+    }
+
+    char *keys[] = {"foo", "bar", "baz", "qux", "quux", "corge", "grault", "garply"};
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        if (!shashtab_oa_set(&tab, keys[i], strlen(keys[i]) + 1, key_func, keys[i]))
+        {
+            return 1;
+        }
+    }
+
+    /* the table grew to keep at least 1/8 of the slots free */
+    printf("%lu %lu\n", tab.length, tab.capacity);
+    /* 8 16 */
+
+    /* setting an existing key keeps its data */
+    shashtab_oa_set(&tab, "foo", 4, key_func, "Hello world");
+    printf("foo: %s\n", (char *) shashtab_oa_get(&tab, "foo", 4, key_func));
+
+    shashtab_oa_del(&tab, "foo", 4, key_func);
+    if (!shashtab_oa_get(&tab, "foo", 4, key_func))
+    {
+        printf("key 'foo' not found\n");
+    }
+    printf("garply: %s\n", (char *) shashtab_oa_get(&tab, "garply", 7, key_func));
+
+    /* cleanup */
+    shashtab_oa_free(&tab);
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SQUEUE_IMPLEMENTATION
+#include "../squeue.h"
+
+#define MAX_THREADS 16
+#define PING_COUNT 100000
+
+static long count = 10000000;
+static int threads = 2;
+
+/* static storage keeps the over-aligned queues aligned */
+static squeue_spsc spsc;
+static squeue_spsc spsc_back;
+static squeue_mpmc mpmc;
+static squeue_mpmc mpmc_back;
+static atomic_long mpmc_sum;
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* spins for a while, then lets the other threads run on a busy machine */
+static void backoff(unsigned * const spins)
+{
+    if (++*spins % 64 == 0)
+    {
+        sched_yield();
+    }
+}
+
+static void *spsc_producer(void *arg)
+{
+    (void) arg;
+    for (long i = 1; i <= count; i++)
+    {
+        unsigned spins = 0;
+        while (!squeue_spsc_push(&spsc, &i))
+        {
+            backoff(&spins);
+        }
+    }
+    return NULL;
+}
+
+static void *mpmc_producer(void *arg)
+{
+    long const n = *(long *) arg;
+    for (long i = 1; i <= n; i++)
+    {
+        unsigned spins = 0;
+        while (!squeue_mpmc_push(&mpmc, &i))
+        {
+            backoff(&spins);
+        }
+    }
+    return NULL;
+}
+
+static void *mpmc_consumer(void *arg)
+{
+    long const n = *(long *) arg;
+    long sum = 0;
+    long value;
+    for (long i = 0; i < n; i++)
+    {
+        unsigned spins = 0;
+        while (!squeue_mpmc_pop(&mpmc, &value))
+        {
+            backoff(&spins);
+        }
+        sum += value;
+    }
+    atomic_fetch_add(&mpmc_sum, sum);
+    return NULL;
+}
+
+static void *spsc_echo(void *arg)
+{
+    (void) arg;
+    long value;
+    for (long i = 0; i < PING_COUNT; i++)
+    {
+        unsigned spins = 0;
+        while (!squeue_spsc_pop(&spsc, &value))
+        {
+            backoff(&spins);
+        }
+        while (!squeue_spsc_push(&spsc_back, &value))
+        {
+            backoff(&spins);
+        }
+    }
+    return NULL;
+}
+
+static void *mpmc_echo(void *arg)
+{
+    (void) arg;
+    long value;
+    for (long i = 0; i < PING_COUNT; i++)
+    {
+        unsigned spins = 0;
+        while (!squeue_mpmc_pop(&mpmc, &value))
+        {
+            backoff(&spins);
+        }
+        while (!squeue_mpmc_push(&mpmc_back, &value))
+        {
+            backoff(&spins);
+        }
+    }
+    return NULL;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double const x = *(const double *) a;
+    double const y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* round trips through a queue to an echo thread and back */
+static void ping_pong(char const * const name, bool const use_mpmc)
+{
+    static double samples[PING_COUNT];
+    pthread_t echo;
+    pthread_create(&echo, NULL, use_mpmc ? mpmc_echo : spsc_echo, NULL);
+
+    for (long i = 0; i < PING_COUNT; i++)
+    {
+        long value = i;
+        unsigned spins = 0;
+        double const start = now();
+        if (use_mpmc)
+        {
+            squeue_mpmc_push(&mpmc, &value);
+            while (!squeue_mpmc_pop(&mpmc_back, &value))
+            {
+                backoff(&spins);
+            }
+        }
+        else
+        {
+            squeue_spsc_push(&spsc, &value);
+            while (!squeue_spsc_pop(&spsc_back, &value))
+            {
+                backoff(&spins);
+            }
+        }
+        samples[i] = (now() - start) * 1e9;
+    }
+    pthread_join(echo, NULL);
+
+    qsort(samples, PING_COUNT, sizeof(double), compare_doubles);
+    printf("%-6s round trip  p50 %8.0f ns  p99 %8.0f ns  max %8.0f ns\n", name, samples[PING_COUNT / 2],
+           samples[PING_COUNT / 100 * 99], samples[PING_COUNT - 1]);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        count = atol(argv[1]);
+    }
+    if (argc > 2)
+    {
+        threads = atoi(argv[2]);
+    }
+    if (threads < 1 || threads > MAX_THREADS)
+    {
+        threads = 2;
+    }
+
+    if (!squeue_spsc_init(&spsc, sizeof(long), 1024) || !squeue_spsc_init(&spsc_back, sizeof(long), 1024)
+        || !squeue_mpmc_init(&mpmc, sizeof(long), 1024) || !squeue_mpmc_init(&mpmc_back, sizeof(long), 1024))
+    {
+        return 1;
+    }
+
+    /* SPSC throughput, one producer and the main thread as the consumer */
+    pthread_t producer;
+    double start = now();
+    pthread_create(&producer, NULL, spsc_producer, NULL);
+    long sum = 0;
+    long value;
+    for (long i = 0; i < count; i++)
+    {
+        unsigned spins = 0;
+        while (!squeue_spsc_pop(&spsc, &value))
+        {
+            backoff(&spins);
+        }
+        sum += value;
+    }
+    pthread_join(producer, NULL);
+    double const spsc_time = now() - start;
+    printf("spsc   1 x 1 threads %8.1f M elements/s (sum %ld)\n", count / spsc_time * 1e-6, sum);
+
+    /* MPMC throughput with `threads` producers and as many consumers */
+    pthread_t producers[MAX_THREADS];
+    pthread_t consumers[MAX_THREADS];
+    long per_thread = count / threads;
+    start = now();
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_create(&producers[i], NULL, mpmc_producer, &per_thread);
+        pthread_create(&consumers[i], NULL, mpmc_consumer, &per_thread);
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+    double const mpmc_time = now() - start;
+    printf("mpmc %2d x %d threads %8.1f M elements/s (sum %ld)\n", threads, threads,
+           per_thread * threads / mpmc_time * 1e-6, atomic_load(&mpmc_sum));
+
+    ping_pong("spsc", false);
+    ping_pong("mpmc", true);
+
+    squeue_spsc_destroy(&spsc);
+    squeue_spsc_destroy(&spsc_back);
+    squeue_mpmc_destroy(&mpmc);
+    squeue_mpmc_destroy(&mpmc_back);
+
+    return 0;
+}
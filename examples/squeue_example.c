@@ -0,0 +1,103 @@
+#include <pthread.h>
+#include <stdio.h>
+
+#define SQUEUE_IMPLEMENTATION
+#include "../squeue.h"
+
+#define COUNT 100000
+#define PRODUCERS 2
+#define CONSUMERS 2
+
+squeue_spsc spsc;
+squeue_mpmc mpmc;
+atomic_long mpmc_sum;
+
+void *spsc_producer(void *arg)
+{
+    (void) arg;
+    for (long i = 1; i <= COUNT; i++)
+    {
+        while (!squeue_spsc_push(&spsc, &i))
+        {
+        }
+    }
+    return NULL;
+}
+
+void *mpmc_producer(void *arg)
+{
+    (void) arg;
+    for (long i = 1; i <= COUNT; i++)
+    {
+        while (!squeue_mpmc_push(&mpmc, &i))
+        {
+        }
+    }
+    return NULL;
+}
+
+void *mpmc_consumer(void *arg)
+{
+    (void) arg;
+    long sum = 0;
+    long value;
+    for (long i = 0; i < COUNT * PRODUCERS / CONSUMERS; i++)
+    {
+        while (!squeue_mpmc_pop(&mpmc, &value))
+        {
+        }
+        sum += value;
+    }
+    atomic_fetch_add(&mpmc_sum, sum);
+    return NULL;
+}
+
+int main()
+{
+    if (!squeue_spsc_init(&spsc, sizeof(long), 1024) || !squeue_mpmc_init(&mpmc, sizeof(long), 1024))
+    {
+        return 1;
+    }
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, spsc_producer, NULL);
+
+    long sum = 0;
+    long value;
+    for (long i = 0; i < COUNT; i++)
+    {
+        while (!squeue_spsc_pop(&spsc, &value))
+        {
+        }
+        sum += value;
+    }
+    pthread_join(producer, NULL);
+    printf("%ld\n", sum);
+    /* 5000050000 */
+
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+    for (int i = 0; i < PRODUCERS; i++)
+    {
+        pthread_create(&producers[i], NULL, mpmc_producer, NULL);
+    }
+    for (int i = 0; i < CONSUMERS; i++)
+    {
+        pthread_create(&consumers[i], NULL, mpmc_consumer, NULL);
+    }
+    for (int i = 0; i < PRODUCERS; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    for (int i = 0; i < CONSUMERS; i++)
+    {
+        pthread_join(consumers[i], NULL);
+    }
+    printf("%ld\n", atomic_load(&mpmc_sum));
+    /* 10000100000 */
+
+    squeue_spsc_destroy(&spsc);
+    squeue_mpmc_destroy(&mpmc);
+
+    return 0;
+}
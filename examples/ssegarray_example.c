@@ -0,0 +1,47 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+
+#define SSEGARRAY_IMPLEMENTATION
+#include "../ssegarray.h"
+
+int main()
+{
+    /* blocks of 1 << 4 = 16 ints */
+    ssegarray arr = ssegarray_new(sizeof(int), 4, false);
+
+    int value = 42;
+    int *first = (int *) ssegarray_push(&arr, &value);
+
+    for (int i = 1; i < 100; i++)
+    {
+        ssegarray_push(&arr, &i);
+    }
+    printf("%lu, %lu\n", arr.length, arr.block_count);
+    /* 100, 7 */
+
+    /* growing never moves the existing elements */
+    printf("%d, %d\n", *first, first == ssegarray_at(&arr, 0));
+    /* 42, 1 */
+
+    printf("%d\n", *(int *) ssegarray_at(&arr, 57));
+    /* 57 */
+
+    while (arr.length > 20)
+    {
+        ssegarray_pop(&arr, &value);
+    }
+    ssegarray_shrink_to_fit(&arr);
+    printf("%lu, %lu, %d\n", arr.length, arr.block_count, value);
+    /* 20, 2, 20 */
+
+    ssegarray_free(&arr);
+
+    /* the blocks can also be mapped directly from the OS */
+    ssegarray mapped = ssegarray_new(sizeof(double), 16, true);
+    ssegarray_reserve(&mapped, 1000000);
+    printf("%lu\n", mapped.block_count);
+    /* 16 */
+    ssegarray_free(&mapped);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SSOA_IMPLEMENTATION
+#include "../ssoa.h"
+
+#define SDARRAY_IMPLEMENTATION
+#include "../sdarray.h"
+
+/* a 64-byte row, the scan below reads only `price` */
+typedef struct
+{
+    uint64_t id;
+    double price;
+    int32_t quantity;
+    int32_t flags;
+    char name[40];
+} order;
+
+enum
+{
+    COL_ID,
+    COL_PRICE,
+    COL_QUANTITY,
+    COL_FLAGS,
+    COL_NAME,
+    COL_COUNT
+};
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 10000000;
+    int const rounds = 10;
+
+    size_t const sizes[COL_COUNT] = {sizeof(uint64_t), sizeof(double), sizeof(int32_t), sizeof(int32_t), 40};
+    ssoa soa = ssoa_new(sizes, COL_COUNT, n);
+    sdarray aos = sdarray_new(sizeof(order), n);
+    if (soa.columns == NULL || aos.data == NULL)
+    {
+        return 1;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        order row = {.id = i, .price = (double) (i % 1000) * 0.25, .quantity = (int32_t) (i % 7), .flags = 0, .name = "x"};
+        const void *values[COL_COUNT] = {&row.id, &row.price, &row.quantity, &row.flags, row.name};
+        ssoa_push(&soa, values);
+        sdarray_push(&aos, &row);
+    }
+
+    double sum_aos = 0;
+    double start = now();
+    for (int round = 0; round < rounds; round++)
+    {
+        order const *rows = (order const *) aos.data;
+        for (size_t i = 0; i < aos.length; i++)
+        {
+            sum_aos += rows[i].price;
+        }
+    }
+    double const aos_time = now() - start;
+
+    double sum_soa = 0;
+    start = now();
+    for (int round = 0; round < rounds; round++)
+    {
+        double const *prices = (double const *) ssoa_column(&soa, COL_PRICE);
+        for (size_t i = 0; i < soa.length; i++)
+        {
+            sum_soa += prices[i];
+        }
+    }
+    double const soa_time = now() - start;
+
+    printf("%zu rows of %zu bytes, sum of one double field, %d rounds\n", n, sizeof(order), rounds);
+    printf("sdarray (AoS) %8.1f M rows/s  (%.0f)\n", n * rounds / aos_time * 1e-6, sum_aos);
+    printf("ssoa (SoA)    %8.1f M rows/s  (%.0f)\n", n * rounds / soa_time * 1e-6, sum_soa);
+
+    ssoa_free(&soa);
+    free(aos.data);
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#define SSOA_IMPLEMENTATION
+#include "../ssoa.h"
+
+enum
+{
+    COL_ID,
+    COL_PRICE,
+    COL_QUANTITY,
+    COL_COUNT
+};
+
+int main()
+{
+    size_t const sizes[COL_COUNT] = {sizeof(uint64_t), sizeof(double), sizeof(int)};
+    ssoa orders = ssoa_new(sizes, COL_COUNT, 0);
+    if (orders.columns == NULL)
+    {
+        return 1;
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        uint64_t const id = 1000 + i;
+        double const price = 1.5 * i;
+        int const quantity = i % 3;
+        const void *row[COL_COUNT] = {&id, &price, &quantity};
+        ssoa_push(&orders, row);
+    }
+    printf("%lu, %lu\n", orders.length, orders.capacity);
+    /* 10, 15 */
+
+    ssoa_swap_remove(&orders, 0);
+    ssoa_remove(&orders, 1);
+
+    /* a scan over one column reads only that column's memory */
+    double const *prices = (double const *) ssoa_column(&orders, COL_PRICE);
+    double total = 0;
+    for (size_t i = 0; i < orders.length; i++)
+    {
+        total += prices[i];
+    }
+    printf("%.1f\n", total);
+    /* 66.0 */
+
+    printf("%lu, %d\n", *(uint64_t *) ssoa_at(&orders, COL_ID, 0), *(int *) ssoa_at(&orders, COL_QUANTITY, 0));
+    /* 1009, 0 */
+
+    ssoa_free(&orders);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SULIST_IMPLEMENTATION
+#include "../sulist.h"
+
+#define SDLL_IMPLEMENTATION
+#include "../sdll.h"
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* `alternate` inserts at both ends, so the list order differs from the
+ * allocation order like in a long-lived list */
+static void run(size_t const n, bool const alternate)
+{
+    int const rounds = 20;
+
+    sdll *dll = sdll_new();
+    sulist ul = sulist_new(sizeof(int));
+    if (dll == NULL)
+    {
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        int const value = (int) i;
+        if (alternate && i % 2)
+        {
+            sdll_insert_first(dll, (void *) (uintptr_t) i);
+            sulist_push_front(&ul, &value);
+        }
+        else
+        {
+            sdll_insert_last(dll, (void *) (uintptr_t) i);
+            sulist_push_back(&ul, &value);
+        }
+    }
+
+    long long dll_sum = 0;
+    double start = now();
+    for (int round = 0; round < rounds; round++)
+    {
+        for (sdll_node *node = dll->first; node != NULL; node = node->next)
+        {
+            dll_sum += (int) (uintptr_t) node->data;
+        }
+    }
+    double const dll_time = now() - start;
+
+    long long ul_sum = 0;
+    start = now();
+    for (int round = 0; round < rounds; round++)
+    {
+        for (sulist_iter it = sulist_begin(&ul); it.node != NULL; sulist_next(&it))
+        {
+            ul_sum += *(int *) sulist_get(&ul, it);
+        }
+    }
+    double const ul_time = now() - start;
+
+    printf("%-12s sdll %8.1f M elements/s  sulist %8.1f M elements/s  (%lld, %lld)\n",
+           alternate ? "both ends" : "push back", n * rounds / dll_time * 1e-6, n * rounds / ul_time * 1e-6, dll_sum,
+           ul_sum);
+
+    sdll_free(&dll, sdll_dummy_free);
+    sulist_free(&ul);
+}
+
+int main(int argc, char **argv)
+{
+    size_t const n = argc > 1 ? strtoull(argv[1], NULL, 10) : 2000000;
+
+    printf("traversal of %zu ints\n", n);
+    run(n, false);
+    run(n, true);
+
+    return 0;
+}
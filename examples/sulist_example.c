@@ -0,0 +1,61 @@
+#include <stdio.h>
+
+#define SULIST_IMPLEMENTATION
+#include "../sulist.h"
+
+void print_list(sulist * const l)
+{
+    for (sulist_iter it = sulist_begin(l); it.node != NULL; sulist_next(&it))
+    {
+        printf("%d ", *(int *) sulist_get(l, it));
+    }
+    printf("\n");
+}
+
+int main()
+{
+    sulist l = sulist_new(sizeof(int));
+    printf("%lu\n", l.node_capacity);
+    /* 24 */
+
+    for (int i = 0; i < 50; i++)
+    {
+        sulist_push_back(&l, &i);
+    }
+    int value = -1;
+    sulist_push_front(&l, &value);
+
+    /* 51 elements in 4 nodes */
+    size_t nodes = 0;
+    for (sulist_node *node = l.first; node != NULL; node = node->next)
+    {
+        nodes++;
+    }
+    printf("%lu, %lu\n", l.length, nodes);
+    /* 51, 4 */
+
+    /* remove every element except multiples of 10 */
+    for (sulist_iter it = sulist_begin(&l); it.node != NULL;)
+    {
+        if (*(int *) sulist_get(&l, it) % 10 != 0)
+        {
+            it = sulist_remove(&l, it);
+        }
+        else
+        {
+            sulist_next(&it);
+        }
+    }
+    print_list(&l);
+    /* 0 10 20 30 40 */
+
+    value = 25;
+    sulist_insert(&l, sulist_find(&l, 3), &value, NULL);
+    sulist_pop_front(&l, &value);
+    print_list(&l);
+    /* 10 20 25 30 40 */
+
+    sulist_free(&l);
+
+    return 0;
+}
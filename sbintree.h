@@ -15,13 +15,23 @@
  *         By default, sbintree uses stdlib malloc() and free() for memory
  *         management. You can substitute your own functions instead by defining
  *         these symbols. You must either define both, or neither.
+ *
+ *     #define SBINTREE_ORDER_STATISTICS
+ *
+ *         Every node also stores the size of its subtree, kept up to date by
+ *         insert, remove and rebalancing. This enables O(log n)
+ *         sbintree_select, sbintree_rank and sbintree_count_range.
+ *         The define must be visible wherever sbintree.h is included.
  */
 
 #ifndef INCLUDE_SBINTREE_H
 #define INCLUDE_SBINTREE_H
 
-#include "sdll.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(SBINTREE_MALLOC) && !defined(SBINTREE_FREE) || !defined(SBINTREE_MALLOC) && defined(SBINTREE_FREE)
 #error "You must define both SBINTREE_MALLOC and SBINTREE_FREE, or neither."
@@ -37,6 +47,21 @@ extern "C"
 {
 #endif
 
+/**
+ * Iterates over all nodes of the tree in order without any allocation.
+ * The body must not remove or free the current node.
+ */
+#define SBINTREE_FOREACH(node, root) \
+    for (sbintree *node = sbintree_leftmost(root); node != NULL; node = sbintree_successor(node))
+
+/**
+ * Iterates in order over the nodes with keys in the range [lo, hi), visiting
+ * only those nodes. The body must not remove or free the current node.
+ */
+#define SBINTREE_FOREACH_RANGE(node, root, lo, hi, key_func)                          \
+    for (sbintree *node = sbintree_range_first(root, lo, hi, key_func); node != NULL; \
+         node = sbintree_range_next(node, hi, key_func))
+
 typedef struct sbintree
 {
     struct sbintree *parent;
@@ -44,10 +69,39 @@ typedef struct sbintree
     struct sbintree *right;
     void *key;
     void *data;
+#ifdef SBINTREE_ORDER_STATISTICS
+    /* number of nodes in the subtree rooted at this node */
+    size_t size;
+#endif
+    bool red;
 } sbintree;
 
 sbintree *sbintree_insert(sbintree ** const root, void * const key, int (*key_func)(void *key, void *node_key), void * const data);
 sbintree *sbintree_search(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key));
+
+/**
+ * Links a node allocated by the caller into the tree, e.g. one embedded at the
+ * start of a larger struct. Only the `.key` and `.data` fields have to be set.
+ *
+ * @param root Root of the tree.
+ * @param node Node to insert.
+ * @param key_func Comparison function.
+ * @return The node or `NULL` if its key is already in the tree.
+ */
+sbintree *sbintree_insert_node(sbintree ** const root, sbintree * const node, int (*key_func)(void *key, void *node_key));
+
+/**
+ * Links a node allocated by the caller at an empty position found by the
+ * caller's own search and rebalances the tree. This allows ordering the
+ * nodes by more than what `key_func` sees.
+ *
+ * @param root Root of the tree.
+ * @param parent Node whose child the new node becomes, `NULL` for an empty tree.
+ * @param link The empty child pointer of `parent` (or `root`) to link into.
+ * @param node Node to link.
+ */
+void sbintree_link_node(sbintree ** const root, sbintree * const parent, sbintree ** const link, sbintree * const node);
+/* the callback must not remove or free nodes, use sbintree_free for that */
 void sbintree_inorder(sbintree * const root, void (*callback)(sbintree * const node));
 void sbintree_free(sbintree ** const root, void (*free_func)(sbintree *));
 sbintree *sbintree_leftmost(sbintree * const node);
@@ -56,6 +110,171 @@ sbintree *sbintree_successor(sbintree * const node);
 sbintree *sbintree_predecessor(sbintree * const node);
 void sbintree_remove(sbintree ** const root, sbintree * const node, void (*free_func)(sbintree *));
 
+/* first node with a key not less than the searched key, same as ceiling */
+sbintree *sbintree_lower_bound(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key));
+/* first node with a key greater than the searched key */
+sbintree *sbintree_upper_bound(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key));
+/* last node with a key not greater than the searched key */
+sbintree *sbintree_floor(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key));
+sbintree *sbintree_ceiling(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key));
+
+/**
+ * Finds the first node of the range [lo, hi).
+ *
+ * @param root Root of the tree.
+ * @param lo Inclusive lower bound.
+ * @param hi Exclusive upper bound.
+ * @param key_func Comparison function.
+ * @return First node in the range or `NULL` if the range is empty.
+ */
+sbintree *sbintree_range_first(sbintree * const root, void * const lo, void * const hi,
+                               int (*key_func)(void *searched_key, void *node_key));
+
+/**
+ * Moves to the next node of the range [lo, hi) started by sbintree_range_first.
+ *
+ * @param node Current node of the range.
+ * @param hi Exclusive upper bound.
+ * @param key_func Comparison function.
+ * @return Next node in the range or `NULL` past its end.
+ */
+sbintree *sbintree_range_next(sbintree * const node, void * const hi, int (*key_func)(void *searched_key, void *node_key));
+
+#ifdef SBINTREE_ORDER_STATISTICS
+/**
+ * @param root Root of the tree.
+ * @return Number of nodes in the tree.
+ */
+size_t sbintree_size(sbintree * const root);
+
+/**
+ * Finds the k-th smallest node.
+ *
+ * @param root Root of the tree.
+ * @param k Zero-based rank of the node.
+ * @return Node with `k` smaller keys in the tree or `NULL` if `k` is out of
+ * bounds.
+ */
+sbintree *sbintree_select(sbintree * const root, size_t k);
+
+/**
+ * Counts the keys less than `key`, `key` itself doesn't have to be present.
+ *
+ * @param root Root of the tree.
+ * @param key Searched key.
+ * @param key_func Comparison function.
+ * @return Number of keys less than `key`.
+ */
+size_t sbintree_rank(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key));
+
+/**
+ * Counts the keys in the range [lo, hi).
+ *
+ * @param root Root of the tree.
+ * @param lo Inclusive lower bound.
+ * @param hi Exclusive upper bound.
+ * @param key_func Comparison function.
+ * @return Number of keys in the range.
+ */
+size_t sbintree_count_range(sbintree * const root, void * const lo, void * const hi,
+                            int (*key_func)(void *searched_key, void *node_key));
+#endif
+
+/**
+ * Builds a balanced tree from sorted keys in O(n). The nodes are laid out in
+ * key order in the caller-provided array, so they must not be freed one by one.
+ * Use a `free_func` which doesn't free the node for sbintree_remove and
+ * sbintree_free, and free the array as a whole.
+ *
+ * @param nodes Array of at least `n` nodes.
+ * @param keys Strictly increasing keys.
+ * @param data Data of the keys, can be `NULL`.
+ * @param n Number of keys.
+ * @return Root of the tree, `NULL` if `n` is 0.
+ */
+sbintree *sbintree_build_sorted(sbintree * const nodes, void * const * const keys, void * const * const data, size_t const n);
+
+/**
+ * Merges two trees into a balanced tree built in a node array in O(n + m).
+ * A key present in both trees is stored once with the key and data from `a`,
+ * the node of `b` is passed to `dup_func` so that its key and data can be
+ * released. The nodes of both trees are then released by `free_func`, see
+ * sbintree_free.
+ *
+ * @param a Root of the first tree, set to `NULL`.
+ * @param b Root of the second tree, set to `NULL`.
+ * @param key_func Comparison function.
+ * @param nodes Array with room for the nodes of both trees.
+ * @param free_func Function releasing the nodes of `a` and `b`, it must not
+ * release their key and data which are now owned by the merged tree.
+ * @param dup_func Called with each dropped node of `b`, it must not free the
+ * node itself. Can be `NULL` if `b` doesn't own its keys and data.
+ * @param length Set to the number of nodes of the merged tree.
+ * @return Root of the merged tree.
+ */
+sbintree *sbintree_merge(sbintree ** const a, sbintree ** const b, int (*key_func)(void *key, void *node_key),
+                         sbintree * const nodes, void (*free_func)(sbintree *), void (*dup_func)(sbintree *dropped),
+                         size_t * const length);
+
+/* index of no node in an arena tree */
+#define SBINTREE_ARENA_NIL UINT32_MAX
+
+/**
+ * Node of an arena tree, linked to other nodes by their indices in the arena.
+ */
+typedef struct
+{
+    uint32_t parent;
+    uint32_t left;
+    uint32_t right;
+    bool red;
+    void *key;
+    void *data;
+} sbintree_arena_node;
+
+/**
+ * Red-black tree whose nodes live in one contiguous array. Removed nodes are
+ * kept on a free list linked through `.left` and reused by later inserts.
+ * Node indices stay valid when the array grows, pointers to nodes don't.
+ */
+typedef struct
+{
+    sbintree_arena_node *nodes;
+    uint32_t capacity;
+    /* nodes below this index have been handed out at least once */
+    uint32_t used;
+    uint32_t free_list;
+    uint32_t root;
+    size_t length;
+} sbintree_arena;
+
+sbintree_arena sbintree_arena_new(void);
+bool sbintree_arena_reserve(sbintree_arena * const t, uint32_t const capacity);
+
+/* releases all nodes at once, the keys and data are not touched */
+void sbintree_arena_free(sbintree_arena * const t);
+
+/**
+ * Inserts a key into an arena tree.
+ *
+ * @param t Tree to insert into.
+ * @param key Inserted key.
+ * @param key_func Comparison function.
+ * @param data Data associated with the key.
+ * @return Index of the new node or `SBINTREE_ARENA_NIL` if the key is
+ * already present or the arena cannot grow.
+ */
+uint32_t sbintree_arena_insert(sbintree_arena * const t, void * const key, int (*key_func)(void *key, void *node_key),
+                               void * const data);
+uint32_t sbintree_arena_search(sbintree_arena const * const t, void * const key,
+                               int (*key_func)(void *searched_key, void *node_key));
+
+/* unlinks the node and puts it on the free list */
+void sbintree_arena_remove(sbintree_arena * const t, uint32_t const node);
+sbintree_arena_node *sbintree_arena_at(sbintree_arena const * const t, uint32_t const node);
+uint32_t sbintree_arena_first(sbintree_arena const * const t);
+uint32_t sbintree_arena_next(sbintree_arena const * const t, uint32_t const node);
+
 #ifdef __cplusplus
 }
 #endif
@@ -64,84 +283,220 @@ void sbintree_remove(sbintree ** const root, sbintree * const node, void (*free_
 
 #ifdef SBINTREE_IMPLEMENTATION
 
-sbintree *sbintree_insert(sbintree ** const root, void * const key, int (*key_func)(void *key, void *node_key), void * const data)
+static bool sbintree__is_red(sbintree * const node)
+{
+    return node != NULL && node->red;
+}
+
+static void sbintree__replace_nodes(sbintree ** const root, sbintree * const old_node, sbintree * const new_node)
 {
-    if (*root == NULL)
+    if (old_node->parent == NULL)
     {
-        sbintree *new_node = (sbintree *) SBINTREE_MALLOC(sizeof(sbintree));
-        if (new_node == NULL)
-        {
-            return NULL;
-        }
+        *root = new_node;
+    }
+    else if (old_node == old_node->parent->left)
+    {
+        old_node->parent->left = new_node;
+    }
+    else
+    {
+        old_node->parent->right = new_node;
+    }
+
+    if (new_node != NULL)
+    {
+        new_node->parent = old_node->parent;
+    }
+}
 
-        new_node->parent = NULL;
-        new_node->left = NULL;
-        new_node->right = NULL;
-        new_node->key = key;
-        new_node->data = data;
+#ifdef SBINTREE_ORDER_STATISTICS
+static size_t sbintree__size(sbintree * const node)
+{
+    return node == NULL ? 0 : node->size;
+}
 
-        *root = new_node;
-        return new_node;
+static void sbintree__update_size(sbintree * const node)
+{
+    node->size = sbintree__size(node->left) + sbintree__size(node->right) + 1;
+}
+#endif
+
+static void sbintree__rotate_left(sbintree ** const root, sbintree * const node)
+{
+    sbintree *pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left != NULL)
+    {
+        pivot->left->parent = node;
     }
 
-    sbintree *current = *root;
-    while (current != NULL)
+    sbintree__replace_nodes(root, node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+
+#ifdef SBINTREE_ORDER_STATISTICS
+    pivot->size = node->size;
+    sbintree__update_size(node);
+#endif
+}
+
+static void sbintree__rotate_right(sbintree ** const root, sbintree * const node)
+{
+    sbintree *pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right != NULL)
     {
-        int cmp = key_func(key, current->key);
-        /* left subtree */
-        if (cmp < 0)
+        pivot->right->parent = node;
+    }
+
+    sbintree__replace_nodes(root, node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+
+#ifdef SBINTREE_ORDER_STATISTICS
+    pivot->size = node->size;
+    sbintree__update_size(node);
+#endif
+}
+
+static void sbintree__insert_fixup(sbintree ** const root, sbintree *node)
+{
+    while (sbintree__is_red(node->parent))
+    {
+        sbintree *parent = node->parent;
+        sbintree *grandparent = parent->parent;
+
+        if (parent == grandparent->left)
         {
-            if (current->left != NULL)
+            sbintree *uncle = grandparent->right;
+            if (sbintree__is_red(uncle))
             {
-                current = current->left;
+                parent->red = false;
+                uncle->red = false;
+                grandparent->red = true;
+                node = grandparent;
                 continue;
             }
 
-            sbintree *new_node = (sbintree *) SBINTREE_MALLOC(sizeof(sbintree));
-            if (new_node == NULL)
+            if (node == parent->right)
             {
-                return NULL;
+                sbintree__rotate_left(root, parent);
+                node = parent;
+                parent = node->parent;
             }
-
-            new_node->parent = current;
-            new_node->left = NULL;
-            new_node->right = NULL;
-            new_node->key = key;
-            new_node->data = data;
-
-            current->left = new_node;
-            return new_node;
+            parent->red = false;
+            grandparent->red = true;
+            sbintree__rotate_right(root, grandparent);
         }
-        /* right subtree */
-        else if (cmp > 0)
+        else
         {
-            if (current->right != NULL)
+            sbintree *uncle = grandparent->left;
+            if (sbintree__is_red(uncle))
             {
-                current = current->right;
+                parent->red = false;
+                uncle->red = false;
+                grandparent->red = true;
+                node = grandparent;
                 continue;
             }
 
-            sbintree *new_node = (sbintree *) SBINTREE_MALLOC(sizeof(sbintree));
-            if (new_node == NULL)
+            if (node == parent->left)
             {
-                return NULL;
+                sbintree__rotate_right(root, parent);
+                node = parent;
+                parent = node->parent;
             }
+            parent->red = false;
+            grandparent->red = true;
+            sbintree__rotate_left(root, grandparent);
+        }
+    }
+    (*root)->red = false;
+}
 
-            new_node->parent = current;
-            new_node->left = NULL;
-            new_node->right = NULL;
-            new_node->key = key;
-            new_node->data = data;
-
-            current->right = new_node;
-            return new_node;
+/* finds the link where the key belongs, `NULL` if the key is already in the tree */
+static sbintree **sbintree__find_link(sbintree ** const root, void * const key, int (*key_func)(void *key, void *node_key),
+                                      sbintree ** const parent)
+{
+    sbintree **link = root;
+    *parent = NULL;
+    while (*link != NULL)
+    {
+        int cmp = key_func(key, (*link)->key);
+        *parent = *link;
+        /* left subtree */
+        if (cmp < 0)
+        {
+            link = &(*parent)->left;
+        }
+        /* right subtree */
+        else if (cmp > 0)
+        {
+            link = &(*parent)->right;
         }
         else
         {
             return NULL;
         }
     }
-    return NULL;
+    return link;
+}
+
+static void sbintree__link(sbintree ** const root, sbintree * const parent, sbintree ** const link, sbintree * const node)
+{
+    node->parent = parent;
+    node->left = NULL;
+    node->right = NULL;
+    node->red = true;
+
+    *link = node;
+#ifdef SBINTREE_ORDER_STATISTICS
+    node->size = 1;
+    for (sbintree *current = parent; current != NULL; current = current->parent)
+    {
+        current->size++;
+    }
+#endif
+    sbintree__insert_fixup(root, node);
+}
+
+sbintree *sbintree_insert(sbintree ** const root, void * const key, int (*key_func)(void *key, void *node_key), void * const data)
+{
+    sbintree *parent;
+    sbintree **link = sbintree__find_link(root, key, key_func, &parent);
+    if (link == NULL)
+    {
+        return NULL;
+    }
+
+    sbintree *new_node = (sbintree *) SBINTREE_MALLOC(sizeof(sbintree));
+    if (new_node == NULL)
+    {
+        return NULL;
+    }
+
+    new_node->key = key;
+    new_node->data = data;
+    sbintree__link(root, parent, link, new_node);
+    return new_node;
+}
+
+void sbintree_link_node(sbintree ** const root, sbintree * const parent, sbintree ** const link, sbintree * const node)
+{
+    sbintree__link(root, parent, link, node);
+}
+
+sbintree *sbintree_insert_node(sbintree ** const root, sbintree * const node, int (*key_func)(void *key, void *node_key))
+{
+    sbintree *parent;
+    sbintree **link = sbintree__find_link(root, node->key, key_func, &parent);
+    if (link == NULL)
+    {
+        return NULL;
+    }
+
+    sbintree__link(root, parent, link, node);
+    return node;
 }
 
 sbintree *sbintree_search(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key))
@@ -173,37 +528,46 @@ sbintree *sbintree_search(sbintree * const root, void * const key, int (*key_fun
     return NULL;
 }
 
-static void sbintree__left_inorder(sbintree * const root, sdll * const list)
-{
-    for (sbintree *current = root; current != NULL; current = current->left)
-    {
-        sdll_insert_first(list, current);
-    }
-}
-
 void sbintree_inorder(sbintree * const root, void (*callback)(sbintree * const node))
 {
-    if (root == NULL)
-        return;
-
-    sdll *list = sdll_new();
-    sbintree__left_inorder(root, list);
-
-    while (list->first != NULL)
+    for (sbintree *current = sbintree_leftmost(root); current != NULL; current = sbintree_successor(current))
     {
-        sdll_node *first = list->first;
-        sdll_unlink(list, list->first);
-        sbintree__left_inorder(((sbintree *) first->data)->right, list);
-        callback((sbintree *) first->data);
-        SBINTREE_FREE(first);
+        callback(current);
     }
-
-    sdll_free(&list, sdll_dummy_free);
 }
 
 void sbintree_free(sbintree ** const root, void (*free_func)(sbintree *))
 {
-    sbintree_inorder(*root, free_func);
+    /* post-order walk which detaches each leaf before freeing it */
+    sbintree *current = *root;
+    while (current != NULL)
+    {
+        if (current->left != NULL)
+        {
+            current = current->left;
+        }
+        else if (current->right != NULL)
+        {
+            current = current->right;
+        }
+        else
+        {
+            sbintree *parent = current->parent;
+            if (parent != NULL)
+            {
+                if (parent->left == current)
+                {
+                    parent->left = NULL;
+                }
+                else
+                {
+                    parent->right = NULL;
+                }
+            }
+            free_func(current);
+            current = parent;
+        }
+    }
     *root = NULL;
 }
 
@@ -261,57 +625,813 @@ sbintree *sbintree_predecessor(sbintree * const node)
     return predecessor;
 }
 
-static void sbintree__replace_nodes(sbintree ** const root, sbintree * const old_node, sbintree * const new_node)
+static void sbintree__remove_fixup(sbintree ** const root, sbintree *node, sbintree *parent)
 {
-    if (old_node->parent == NULL)
-    {
-        *root = new_node;
-    }
-    else if (old_node == old_node->parent->left)
-    {
-        old_node->parent->left = new_node;
-    }
-    else
+    while (node != *root && !sbintree__is_red(node))
     {
-        old_node->parent->right = new_node;
+        if (node == parent->left)
+        {
+            sbintree *sibling = parent->right;
+            if (sibling->red)
+            {
+                sibling->red = false;
+                parent->red = true;
+                sbintree__rotate_left(root, parent);
+                sibling = parent->right;
+            }
+
+            if (!sbintree__is_red(sibling->left) && !sbintree__is_red(sibling->right))
+            {
+                sibling->red = true;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+
+            if (!sbintree__is_red(sibling->right))
+            {
+                sibling->left->red = false;
+                sibling->red = true;
+                sbintree__rotate_right(root, sibling);
+                sibling = parent->right;
+            }
+            sibling->red = parent->red;
+            parent->red = false;
+            sibling->right->red = false;
+            sbintree__rotate_left(root, parent);
+            node = *root;
+        }
+        else
+        {
+            sbintree *sibling = parent->left;
+            if (sibling->red)
+            {
+                sibling->red = false;
+                parent->red = true;
+                sbintree__rotate_right(root, parent);
+                sibling = parent->left;
+            }
+
+            if (!sbintree__is_red(sibling->left) && !sbintree__is_red(sibling->right))
+            {
+                sibling->red = true;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+
+            if (!sbintree__is_red(sibling->left))
+            {
+                sibling->right->red = false;
+                sibling->red = true;
+                sbintree__rotate_left(root, sibling);
+                sibling = parent->left;
+            }
+            sibling->red = parent->red;
+            parent->red = false;
+            sibling->left->red = false;
+            sbintree__rotate_right(root, parent);
+            node = *root;
+        }
     }
 
-    if (new_node != NULL)
+    if (node != NULL)
     {
-        new_node->parent = old_node->parent;
+        node->red = false;
     }
 }
 
 void sbintree_remove(sbintree ** const root, sbintree * const node, void (*free_func)(sbintree *))
 {
-    if (node->left == NULL)
+    /* child takes the place of the node that is unlinked from the tree */
+    sbintree *child;
+    sbintree *child_parent;
+    bool removed_red;
+
+    if (node->left == NULL || node->right == NULL)
     {
-        sbintree__replace_nodes(root, node, node->right);
-        free_func(node);
-        return;
+        child = node->left != NULL ? node->left : node->right;
+        child_parent = node->parent;
+        removed_red = node->red;
+        sbintree__replace_nodes(root, node, child);
     }
-    else if (node->right == NULL)
+    else
     {
-        sbintree__replace_nodes(root, node, node->left);
-        free_func(node);
-        return;
+        sbintree *replacement = sbintree_leftmost(node->right);
+        child = replacement->right;
+        removed_red = replacement->red;
+
+        if (replacement->parent == node)
+        {
+            child_parent = replacement;
+        }
+        else
+        {
+            child_parent = replacement->parent;
+            sbintree__replace_nodes(root, replacement, replacement->right);
+            replacement->right = node->right;
+            replacement->right->parent = replacement;
+        }
+
+        sbintree__replace_nodes(root, node, replacement);
+        replacement->left = node->left;
+        replacement->left->parent = replacement;
+        replacement->red = node->red;
+#ifdef SBINTREE_ORDER_STATISTICS
+        replacement->size = node->size;
+#endif
     }
 
-    sbintree *replacement = sbintree_successor(node);
-    if (replacement->parent != node)
+#ifdef SBINTREE_ORDER_STATISTICS
+    for (sbintree *current = child_parent; current != NULL; current = current->parent)
     {
-        sbintree__replace_nodes(root, replacement, replacement->right);
-        replacement->right = node->right;
-        replacement->right->parent = replacement;
+        current->size--;
     }
+#endif
 
-    sbintree__replace_nodes(root, node, replacement);
-    replacement->left = node->left;
-    replacement->left->parent = replacement;
+    if (!removed_red)
+    {
+        sbintree__remove_fixup(root, child, child_parent);
+    }
 
     free_func(node);
 }
 
+sbintree *sbintree_lower_bound(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    sbintree *bound = NULL;
+    sbintree *current = root;
+    while (current != NULL)
+    {
+        if (key_func(key, current->key) <= 0)
+        {
+            bound = current;
+            current = current->left;
+        }
+        else
+        {
+            current = current->right;
+        }
+    }
+    return bound;
+}
+
+sbintree *sbintree_upper_bound(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    sbintree *bound = NULL;
+    sbintree *current = root;
+    while (current != NULL)
+    {
+        if (key_func(key, current->key) < 0)
+        {
+            bound = current;
+            current = current->left;
+        }
+        else
+        {
+            current = current->right;
+        }
+    }
+    return bound;
+}
+
+sbintree *sbintree_floor(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    sbintree *bound = NULL;
+    sbintree *current = root;
+    while (current != NULL)
+    {
+        if (key_func(key, current->key) >= 0)
+        {
+            bound = current;
+            current = current->right;
+        }
+        else
+        {
+            current = current->left;
+        }
+    }
+    return bound;
+}
+
+sbintree *sbintree_ceiling(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    return sbintree_lower_bound(root, key, key_func);
+}
+
+sbintree *sbintree_range_first(sbintree * const root, void * const lo, void * const hi,
+                               int (*key_func)(void *searched_key, void *node_key))
+{
+    sbintree *first = sbintree_lower_bound(root, lo, key_func);
+    if (first == NULL || key_func(hi, first->key) <= 0)
+    {
+        return NULL;
+    }
+    return first;
+}
+
+sbintree *sbintree_range_next(sbintree * const node, void * const hi, int (*key_func)(void *searched_key, void *node_key))
+{
+    sbintree *next = sbintree_successor(node);
+    if (next == NULL || key_func(hi, next->key) <= 0)
+    {
+        return NULL;
+    }
+    return next;
+}
+
+#ifdef SBINTREE_ORDER_STATISTICS
+size_t sbintree_size(sbintree * const root)
+{
+    return sbintree__size(root);
+}
+
+sbintree *sbintree_select(sbintree * const root, size_t k)
+{
+    sbintree *current = root;
+    while (current != NULL)
+    {
+        size_t left_size = sbintree__size(current->left);
+        if (k < left_size)
+        {
+            current = current->left;
+        }
+        else if (k > left_size)
+        {
+            k -= left_size + 1;
+            current = current->right;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return NULL;
+}
+
+size_t sbintree_rank(sbintree * const root, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    size_t rank = 0;
+    sbintree *current = root;
+    while (current != NULL)
+    {
+        int cmp = key_func(key, current->key);
+        if (cmp > 0)
+        {
+            rank += sbintree__size(current->left) + 1;
+            current = current->right;
+        }
+        else if (cmp < 0)
+        {
+            current = current->left;
+        }
+        else
+        {
+            return rank + sbintree__size(current->left);
+        }
+    }
+    return rank;
+}
+
+size_t sbintree_count_range(sbintree * const root, void * const lo, void * const hi,
+                            int (*key_func)(void *searched_key, void *node_key))
+{
+    size_t lo_rank = sbintree_rank(root, lo, key_func);
+    size_t hi_rank = sbintree_rank(root, hi, key_func);
+    return hi_rank > lo_rank ? hi_rank - lo_rank : 0;
+}
+#endif
+
+/* links nodes[low, high) into a subtree, the nodes at depth `red_depth` are red */
+static sbintree *sbintree__link_sorted(sbintree * const nodes, size_t const low, size_t const high,
+                                       sbintree * const parent, size_t const depth, size_t const red_depth)
+{
+    if (low == high)
+    {
+        return NULL;
+    }
+
+    size_t mid = low + (high - low) / 2;
+    sbintree *node = &nodes[mid];
+    node->parent = parent;
+    node->left = sbintree__link_sorted(nodes, low, mid, node, depth + 1, red_depth);
+    node->right = sbintree__link_sorted(nodes, mid + 1, high, node, depth + 1, red_depth);
+    node->red = depth == red_depth;
+#ifdef SBINTREE_ORDER_STATISTICS
+    node->size = high - low;
+#endif
+
+    return node;
+}
+
+static sbintree *sbintree__link_all(sbintree * const nodes, size_t const n)
+{
+    /* the levels above red_depth are full, so only the last level may be partial */
+    size_t red_depth = 0;
+    while (((size_t) 2 << red_depth) - 1 <= n)
+    {
+        red_depth++;
+    }
+    return sbintree__link_sorted(nodes, 0, n, NULL, 0, red_depth);
+}
+
+sbintree *sbintree_build_sorted(sbintree * const nodes, void * const * const keys, void * const * const data, size_t const n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        nodes[i].key = keys[i];
+        nodes[i].data = data == NULL ? NULL : data[i];
+    }
+    return sbintree__link_all(nodes, n);
+}
+
+sbintree *sbintree_merge(sbintree ** const a, sbintree ** const b, int (*key_func)(void *key, void *node_key),
+                         sbintree * const nodes, void (*free_func)(sbintree *), void (*dup_func)(sbintree *dropped),
+                         size_t * const length)
+{
+    sbintree *next_a = sbintree_leftmost(*a);
+    sbintree *next_b = sbintree_leftmost(*b);
+    size_t n = 0;
+    while (next_a != NULL || next_b != NULL)
+    {
+        int cmp;
+        if (next_a == NULL)
+        {
+            cmp = 1;
+        }
+        else if (next_b == NULL)
+        {
+            cmp = -1;
+        }
+        else
+        {
+            cmp = key_func(next_a->key, next_b->key);
+        }
+
+        sbintree *taken = cmp <= 0 ? next_a : next_b;
+        nodes[n].key = taken->key;
+        nodes[n].data = taken->data;
+        n++;
+
+        if (cmp <= 0)
+        {
+            next_a = sbintree_successor(next_a);
+        }
+        if (cmp >= 0)
+        {
+            /* the key of `b` is a duplicate, hand it back to the caller */
+            if (cmp == 0 && dup_func != NULL)
+            {
+                dup_func(next_b);
+            }
+            next_b = sbintree_successor(next_b);
+        }
+    }
+
+    sbintree_free(a, free_func);
+    sbintree_free(b, free_func);
+
+    *length = n;
+    return sbintree__link_all(nodes, n);
+}
+
+sbintree_arena sbintree_arena_new(void)
+{
+    sbintree_arena t = {
+        .nodes = NULL,
+        .capacity = 0,
+        .used = 0,
+        .free_list = SBINTREE_ARENA_NIL,
+        .root = SBINTREE_ARENA_NIL,
+        .length = 0,
+    };
+    return t;
+}
+
+bool sbintree_arena_reserve(sbintree_arena * const t, uint32_t const capacity)
+{
+    if (capacity <= t->capacity)
+    {
+        return true;
+    }
+
+    sbintree_arena_node *nodes = (sbintree_arena_node *) SBINTREE_MALLOC(sizeof(sbintree_arena_node) * capacity);
+    if (nodes == NULL)
+    {
+        return false;
+    }
+
+    if (t->nodes != NULL)
+    {
+        memcpy(nodes, t->nodes, sizeof(sbintree_arena_node) * t->used);
+        SBINTREE_FREE(t->nodes);
+    }
+    t->nodes = nodes;
+    t->capacity = capacity;
+
+    return true;
+}
+
+void sbintree_arena_free(sbintree_arena * const t)
+{
+    SBINTREE_FREE(t->nodes);
+    *t = sbintree_arena_new();
+}
+
+static uint32_t sbintree__arena_alloc(sbintree_arena * const t)
+{
+    if (t->free_list != SBINTREE_ARENA_NIL)
+    {
+        uint32_t node = t->free_list;
+        t->free_list = t->nodes[node].left;
+        return node;
+    }
+
+    if (t->used == t->capacity)
+    {
+        /* SBINTREE_ARENA_NIL itself is not a valid index */
+        uint64_t const max_capacity = SBINTREE_ARENA_NIL;
+        uint64_t const new_length = (uint64_t) t->used + 1;
+        /* ceil(new_length * 1.5) */
+        uint64_t new_capacity = 3 * new_length / 2 + ((new_length % 2) != 0);
+        if (new_capacity < 16)
+        {
+            new_capacity = 16;
+        }
+        if (new_capacity > max_capacity)
+        {
+            new_capacity = max_capacity;
+        }
+
+        if (new_length > new_capacity || !sbintree_arena_reserve(t, (uint32_t) new_capacity))
+        {
+            return SBINTREE_ARENA_NIL;
+        }
+    }
+
+    return t->used++;
+}
+
+static bool sbintree__arena_is_red(sbintree_arena const * const t, uint32_t const node)
+{
+    return node != SBINTREE_ARENA_NIL && t->nodes[node].red;
+}
+
+static void sbintree__arena_replace_nodes(sbintree_arena * const t, uint32_t const old_node, uint32_t const new_node)
+{
+    uint32_t parent = t->nodes[old_node].parent;
+    if (parent == SBINTREE_ARENA_NIL)
+    {
+        t->root = new_node;
+    }
+    else if (old_node == t->nodes[parent].left)
+    {
+        t->nodes[parent].left = new_node;
+    }
+    else
+    {
+        t->nodes[parent].right = new_node;
+    }
+
+    if (new_node != SBINTREE_ARENA_NIL)
+    {
+        t->nodes[new_node].parent = parent;
+    }
+}
+
+static void sbintree__arena_rotate_left(sbintree_arena * const t, uint32_t const node)
+{
+    uint32_t pivot = t->nodes[node].right;
+    t->nodes[node].right = t->nodes[pivot].left;
+    if (t->nodes[pivot].left != SBINTREE_ARENA_NIL)
+    {
+        t->nodes[t->nodes[pivot].left].parent = node;
+    }
+
+    sbintree__arena_replace_nodes(t, node, pivot);
+    t->nodes[pivot].left = node;
+    t->nodes[node].parent = pivot;
+}
+
+static void sbintree__arena_rotate_right(sbintree_arena * const t, uint32_t const node)
+{
+    uint32_t pivot = t->nodes[node].left;
+    t->nodes[node].left = t->nodes[pivot].right;
+    if (t->nodes[pivot].right != SBINTREE_ARENA_NIL)
+    {
+        t->nodes[t->nodes[pivot].right].parent = node;
+    }
+
+    sbintree__arena_replace_nodes(t, node, pivot);
+    t->nodes[pivot].right = node;
+    t->nodes[node].parent = pivot;
+}
+
+static void sbintree__arena_insert_fixup(sbintree_arena * const t, uint32_t node)
+{
+    sbintree_arena_node *nodes = t->nodes;
+    while (sbintree__arena_is_red(t, nodes[node].parent))
+    {
+        uint32_t parent = nodes[node].parent;
+        uint32_t grandparent = nodes[parent].parent;
+
+        if (parent == nodes[grandparent].left)
+        {
+            uint32_t uncle = nodes[grandparent].right;
+            if (sbintree__arena_is_red(t, uncle))
+            {
+                nodes[parent].red = false;
+                nodes[uncle].red = false;
+                nodes[grandparent].red = true;
+                node = grandparent;
+                continue;
+            }
+
+            if (node == nodes[parent].right)
+            {
+                sbintree__arena_rotate_left(t, parent);
+                node = parent;
+                parent = nodes[node].parent;
+            }
+            nodes[parent].red = false;
+            nodes[grandparent].red = true;
+            sbintree__arena_rotate_right(t, grandparent);
+        }
+        else
+        {
+            uint32_t uncle = nodes[grandparent].left;
+            if (sbintree__arena_is_red(t, uncle))
+            {
+                nodes[parent].red = false;
+                nodes[uncle].red = false;
+                nodes[grandparent].red = true;
+                node = grandparent;
+                continue;
+            }
+
+            if (node == nodes[parent].left)
+            {
+                sbintree__arena_rotate_right(t, parent);
+                node = parent;
+                parent = nodes[node].parent;
+            }
+            nodes[parent].red = false;
+            nodes[grandparent].red = true;
+            sbintree__arena_rotate_left(t, grandparent);
+        }
+    }
+    nodes[t->root].red = false;
+}
+
+uint32_t sbintree_arena_insert(sbintree_arena * const t, void * const key, int (*key_func)(void *key, void *node_key),
+                               void * const data)
+{
+    uint32_t parent = SBINTREE_ARENA_NIL;
+    uint32_t current = t->root;
+    int cmp = 0;
+    while (current != SBINTREE_ARENA_NIL)
+    {
+        cmp = key_func(key, t->nodes[current].key);
+        parent = current;
+        /* left subtree */
+        if (cmp < 0)
+        {
+            current = t->nodes[current].left;
+        }
+        /* right subtree */
+        else if (cmp > 0)
+        {
+            current = t->nodes[current].right;
+        }
+        else
+        {
+            return SBINTREE_ARENA_NIL;
+        }
+    }
+
+    /* may move the nodes, so no pointers into the arena are held across it */
+    uint32_t new_node = sbintree__arena_alloc(t);
+    if (new_node == SBINTREE_ARENA_NIL)
+    {
+        return SBINTREE_ARENA_NIL;
+    }
+
+    t->nodes[new_node].parent = parent;
+    t->nodes[new_node].left = SBINTREE_ARENA_NIL;
+    t->nodes[new_node].right = SBINTREE_ARENA_NIL;
+    t->nodes[new_node].red = true;
+    t->nodes[new_node].key = key;
+    t->nodes[new_node].data = data;
+
+    if (parent == SBINTREE_ARENA_NIL)
+    {
+        t->root = new_node;
+    }
+    else if (cmp < 0)
+    {
+        t->nodes[parent].left = new_node;
+    }
+    else
+    {
+        t->nodes[parent].right = new_node;
+    }
+
+    sbintree__arena_insert_fixup(t, new_node);
+    t->length++;
+    return new_node;
+}
+
+uint32_t sbintree_arena_search(sbintree_arena const * const t, void * const key,
+                               int (*key_func)(void *searched_key, void *node_key))
+{
+    uint32_t current = t->root;
+    while (current != SBINTREE_ARENA_NIL)
+    {
+        int cmp = key_func(key, t->nodes[current].key);
+        /* left subtree */
+        if (cmp < 0)
+        {
+            current = t->nodes[current].left;
+        }
+        /* right subtree */
+        else if (cmp > 0)
+        {
+            current = t->nodes[current].right;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return SBINTREE_ARENA_NIL;
+}
+
+static uint32_t sbintree__arena_leftmost(sbintree_arena const * const t, uint32_t node)
+{
+    if (node == SBINTREE_ARENA_NIL)
+    {
+        return SBINTREE_ARENA_NIL;
+    }
+    while (t->nodes[node].left != SBINTREE_ARENA_NIL)
+    {
+        node = t->nodes[node].left;
+    }
+    return node;
+}
+
+static void sbintree__arena_remove_fixup(sbintree_arena * const t, uint32_t node, uint32_t parent)
+{
+    sbintree_arena_node *nodes = t->nodes;
+    while (node != t->root && !sbintree__arena_is_red(t, node))
+    {
+        if (node == nodes[parent].left)
+        {
+            uint32_t sibling = nodes[parent].right;
+            if (nodes[sibling].red)
+            {
+                nodes[sibling].red = false;
+                nodes[parent].red = true;
+                sbintree__arena_rotate_left(t, parent);
+                sibling = nodes[parent].right;
+            }
+
+            if (!sbintree__arena_is_red(t, nodes[sibling].left) && !sbintree__arena_is_red(t, nodes[sibling].right))
+            {
+                nodes[sibling].red = true;
+                node = parent;
+                parent = nodes[node].parent;
+                continue;
+            }
+
+            if (!sbintree__arena_is_red(t, nodes[sibling].right))
+            {
+                nodes[nodes[sibling].left].red = false;
+                nodes[sibling].red = true;
+                sbintree__arena_rotate_right(t, sibling);
+                sibling = nodes[parent].right;
+            }
+            nodes[sibling].red = nodes[parent].red;
+            nodes[parent].red = false;
+            nodes[nodes[sibling].right].red = false;
+            sbintree__arena_rotate_left(t, parent);
+            node = t->root;
+        }
+        else
+        {
+            uint32_t sibling = nodes[parent].left;
+            if (nodes[sibling].red)
+            {
+                nodes[sibling].red = false;
+                nodes[parent].red = true;
+                sbintree__arena_rotate_right(t, parent);
+                sibling = nodes[parent].left;
+            }
+
+            if (!sbintree__arena_is_red(t, nodes[sibling].left) && !sbintree__arena_is_red(t, nodes[sibling].right))
+            {
+                nodes[sibling].red = true;
+                node = parent;
+                parent = nodes[node].parent;
+                continue;
+            }
+
+            if (!sbintree__arena_is_red(t, nodes[sibling].left))
+            {
+                nodes[nodes[sibling].right].red = false;
+                nodes[sibling].red = true;
+                sbintree__arena_rotate_left(t, sibling);
+                sibling = nodes[parent].left;
+            }
+            nodes[sibling].red = nodes[parent].red;
+            nodes[parent].red = false;
+            nodes[nodes[sibling].left].red = false;
+            sbintree__arena_rotate_right(t, parent);
+            node = t->root;
+        }
+    }
+
+    if (node != SBINTREE_ARENA_NIL)
+    {
+        nodes[node].red = false;
+    }
+}
+
+void sbintree_arena_remove(sbintree_arena * const t, uint32_t const node)
+{
+    sbintree_arena_node *nodes = t->nodes;
+    /* child takes the place of the node that is unlinked from the tree */
+    uint32_t child;
+    uint32_t child_parent;
+    bool removed_red;
+
+    if (nodes[node].left == SBINTREE_ARENA_NIL || nodes[node].right == SBINTREE_ARENA_NIL)
+    {
+        child = nodes[node].left != SBINTREE_ARENA_NIL ? nodes[node].left : nodes[node].right;
+        child_parent = nodes[node].parent;
+        removed_red = nodes[node].red;
+        sbintree__arena_replace_nodes(t, node, child);
+    }
+    else
+    {
+        uint32_t replacement = sbintree__arena_leftmost(t, nodes[node].right);
+        child = nodes[replacement].right;
+        removed_red = nodes[replacement].red;
+
+        if (nodes[replacement].parent == node)
+        {
+            child_parent = replacement;
+        }
+        else
+        {
+            child_parent = nodes[replacement].parent;
+            sbintree__arena_replace_nodes(t, replacement, nodes[replacement].right);
+            nodes[replacement].right = nodes[node].right;
+            nodes[nodes[replacement].right].parent = replacement;
+        }
+
+        sbintree__arena_replace_nodes(t, node, replacement);
+        nodes[replacement].left = nodes[node].left;
+        nodes[nodes[replacement].left].parent = replacement;
+        nodes[replacement].red = nodes[node].red;
+    }
+
+    if (!removed_red)
+    {
+        sbintree__arena_remove_fixup(t, child, child_parent);
+    }
+
+    nodes[node].left = t->free_list;
+    t->free_list = node;
+    t->length--;
+}
+
+sbintree_arena_node *sbintree_arena_at(sbintree_arena const * const t, uint32_t const node)
+{
+    return &t->nodes[node];
+}
+
+uint32_t sbintree_arena_first(sbintree_arena const * const t)
+{
+    return sbintree__arena_leftmost(t, t->root);
+}
+
+uint32_t sbintree_arena_next(sbintree_arena const * const t, uint32_t const node)
+{
+    if (t->nodes[node].right != SBINTREE_ARENA_NIL)
+    {
+        return sbintree__arena_leftmost(t, t->nodes[node].right);
+    }
+
+    uint32_t current = node;
+    uint32_t successor = t->nodes[node].parent;
+    while (successor != SBINTREE_ARENA_NIL && current == t->nodes[successor].right)
+    {
+        current = successor;
+        successor = t->nodes[successor].parent;
+    }
+    return successor;
+}
+
 #endif /*SBINTREE_IMPLEMENTATION*/
 
 /*
@@ -0,0 +1,700 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     #define SBTREE_MALLOC(size) malloc(size)
+ *     #define SBTREE_FREE(ptr)    free(ptr)
+ *
+ *         These defines only need to be set in the file containing
+ *         #define SBTREE_IMPLEMENTATION.
+ *
+ *         By default, sbtree uses stdlib malloc() and free() for memory
+ *         management. You can substitute your own functions instead by defining
+ *         these symbols. You must either define both, or neither.
+ *
+ *     #define SBTREE_NODE_KEYS 32
+ *
+ *         Maximum number of keys in one node, must be even and at least 4.
+ *         With the default, the key array of a node spans four cache lines.
+ *
+ * In-memory B+-tree ordered map. Keys and data are stored in sorted arrays
+ * inside the nodes, so a lookup touches one node per level of a shallow tree
+ * instead of one node per key comparison. Leaves are linked for range scans.
+ * Keys are compared by a `key_func` with the same convention as in sbintree.
+ */
+
+#ifndef INCLUDE_SBTREE_H
+#define INCLUDE_SBTREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(SBTREE_MALLOC) && !defined(SBTREE_FREE) || !defined(SBTREE_MALLOC) && defined(SBTREE_FREE)
+#error "You must define both SBTREE_MALLOC and SBTREE_FREE, or neither."
+#endif
+#if !defined(SBTREE_MALLOC) && !defined(SBTREE_FREE)
+#include <stdlib.h>
+#define SBTREE_MALLOC(size) malloc(size)
+#define SBTREE_FREE(ptr) free(ptr)
+#endif
+
+#if !defined(SBTREE_NODE_KEYS)
+#define SBTREE_NODE_KEYS 32
+#endif
+
+#if SBTREE_NODE_KEYS < 4 || SBTREE_NODE_KEYS % 2 != 0
+#error "SBTREE_NODE_KEYS must be even and at least 4."
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Leaves store the data of their keys in `values`, inner nodes store
+ * `count + 1` child pointers there. The separator `keys[i]` of an inner node is
+ * the smallest key in the subtree of child `i + 1`.
+ */
+typedef struct sbtree_node
+{
+    /* neighbouring leaves, unused in inner nodes */
+    struct sbtree_node *next;
+    struct sbtree_node *prev;
+    unsigned int count;
+    bool leaf;
+    void *keys[SBTREE_NODE_KEYS];
+    void *values[SBTREE_NODE_KEYS + 1];
+} sbtree_node;
+
+typedef struct
+{
+    sbtree_node *root;
+    size_t length;
+} sbtree;
+
+/**
+ * Position of a key, `.node == NULL` is the end of the tree.
+ */
+typedef struct
+{
+    sbtree_node *node;
+    unsigned int index;
+} sbtree_iter;
+
+sbtree sbtree_new(void);
+void sbtree_free(sbtree * const t, void (*free_func)(void *key, void *data));
+void sbtree_dummy_free(void *key, void *data);
+
+/**
+ * Inserts a key, splitting full nodes on the way down.
+ *
+ * @param t Tree to insert into.
+ * @param key Inserted key.
+ * @param key_func Comparison function of the searched key and a key stored
+ * in the tree.
+ * @param data Data associated with the key.
+ * @return `true` upon success, `false` if the key is already present or on
+ * allocation failure.
+ */
+bool sbtree_insert(sbtree * const t, void * const key, int (*key_func)(void *key, void *node_key), void * const data);
+
+/**
+ * Finds the data of a key.
+ *
+ * @param t Tree to search.
+ * @param key Searched key.
+ * @param key_func Comparison function.
+ * @return Pointer to the data of the key, which stays valid until the next
+ * insert or remove, or `NULL` if the key is not present.
+ */
+void **sbtree_search(sbtree const * const t, void * const key, int (*key_func)(void *searched_key, void *node_key));
+
+/**
+ * Removes a key, refilling nodes on the way down so that no node underflows.
+ *
+ * @param t Tree to remove from.
+ * @param key Removed key.
+ * @param key_func Comparison function.
+ * @param free_func Called with the removed key and its data.
+ * @return `true` if the key was found and removed.
+ */
+bool sbtree_remove(sbtree * const t, void * const key, int (*key_func)(void *searched_key, void *node_key),
+                   void (*free_func)(void *key, void *data));
+
+sbtree_iter sbtree_begin(sbtree const * const t);
+void sbtree_next(sbtree_iter * const it);
+void *sbtree_key(sbtree_iter const it);
+void *sbtree_data(sbtree_iter const it);
+
+/**
+ * Finds the first key that is not less than `key`.
+ *
+ * @param t Tree to search.
+ * @param key Searched key.
+ * @param key_func Comparison function.
+ * @return Position of the found key or the end iterator.
+ */
+sbtree_iter sbtree_lower_bound(sbtree const * const t, void * const key, int (*key_func)(void *searched_key, void *node_key));
+
+/**
+ * Calls `callback` for every key in the range [lo, hi) in order.
+ *
+ * @param t Tree to scan.
+ * @param lo Inclusive lower bound.
+ * @param hi Exclusive upper bound.
+ * @param key_func Comparison function.
+ * @param callback Called with each key, its data and `ctx`.
+ * @param ctx User context passed to `callback`.
+ * @return Number of visited keys.
+ */
+size_t sbtree_range(sbtree const * const t, void * const lo, void * const hi,
+                    int (*key_func)(void *searched_key, void *node_key),
+                    void (*callback)(void *key, void *data, void *ctx), void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*INCLUDE_SBTREE_H*/
+
+#ifdef SBTREE_IMPLEMENTATION
+
+/* a non-root node never has fewer keys */
+#define SBTREE__MIN_KEYS (SBTREE_NODE_KEYS / 2 - 1)
+
+static sbtree_node *sbtree__child(sbtree_node * const node, unsigned int const index)
+{
+    return (sbtree_node *) node->values[index];
+}
+
+static sbtree_node *sbtree__node_new(bool const leaf)
+{
+    sbtree_node *node = (sbtree_node *) SBTREE_MALLOC(sizeof(sbtree_node));
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+    node->count = 0;
+    node->leaf = leaf;
+
+    return node;
+}
+
+/* index of the first key which is not less than the searched key */
+static unsigned int sbtree__lower_bound(sbtree_node * const node, void * const key, int (*key_func)(void *, void *))
+{
+    unsigned int low = 0;
+    unsigned int high = node->count;
+    while (low < high)
+    {
+        unsigned int mid = low + (high - low) / 2;
+        if (key_func(key, node->keys[mid]) > 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* index of the child of an inner node whose subtree may contain the key */
+static unsigned int sbtree__child_index(sbtree_node * const node, void * const key, int (*key_func)(void *, void *))
+{
+    unsigned int low = 0;
+    unsigned int high = node->count;
+    while (low < high)
+    {
+        unsigned int mid = low + (high - low) / 2;
+        if (key_func(key, node->keys[mid]) >= 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static sbtree_node *sbtree__find_leaf(sbtree const * const t, void * const key, int (*key_func)(void *, void *))
+{
+    sbtree_node *node = t->root;
+    while (node != NULL && !node->leaf)
+    {
+        node = sbtree__child(node, sbtree__child_index(node, key, key_func));
+    }
+    return node;
+}
+
+sbtree sbtree_new(void)
+{
+    sbtree t = {
+        .root = NULL,
+        .length = 0,
+    };
+    return t;
+}
+
+static void sbtree__free_node(sbtree_node * const node, void (*free_func)(void *key, void *data))
+{
+    if (node->leaf)
+    {
+        for (unsigned int i = 0; i < node->count; i++)
+        {
+            free_func(node->keys[i], node->values[i]);
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i <= node->count; i++)
+        {
+            sbtree__free_node(sbtree__child(node, i), free_func);
+        }
+    }
+    SBTREE_FREE(node);
+}
+
+void sbtree_free(sbtree * const t, void (*free_func)(void *key, void *data))
+{
+    if (t->root != NULL)
+    {
+        sbtree__free_node(t->root, free_func);
+    }
+    t->root = NULL;
+    t->length = 0;
+}
+
+void sbtree_dummy_free(void *key, void *data)
+{
+    (void) key;
+    (void) data;
+}
+
+/* splits the full child at `index` into two and inserts the separator into the parent */
+static bool sbtree__split_child(sbtree_node * const parent, unsigned int const index)
+{
+    sbtree_node *child = sbtree__child(parent, index);
+    sbtree_node *sibling = sbtree__node_new(child->leaf);
+    if (sibling == NULL)
+    {
+        return false;
+    }
+
+    unsigned int const half = SBTREE_NODE_KEYS / 2;
+    void *separator;
+    if (child->leaf)
+    {
+        memcpy(sibling->keys, child->keys + half, sizeof(void *) * (SBTREE_NODE_KEYS - half));
+        memcpy(sibling->values, child->values + half, sizeof(void *) * (SBTREE_NODE_KEYS - half));
+        sibling->count = SBTREE_NODE_KEYS - half;
+        child->count = half;
+        separator = sibling->keys[0];
+
+        sibling->prev = child;
+        sibling->next = child->next;
+        if (sibling->next != NULL)
+        {
+            sibling->next->prev = sibling;
+        }
+        child->next = sibling;
+    }
+    else
+    {
+        /* the middle key moves up to the parent */
+        separator = child->keys[half];
+        memcpy(sibling->keys, child->keys + half + 1, sizeof(void *) * (SBTREE_NODE_KEYS - half - 1));
+        memcpy(sibling->values, child->values + half + 1, sizeof(void *) * (SBTREE_NODE_KEYS - half));
+        sibling->count = SBTREE_NODE_KEYS - half - 1;
+        child->count = half;
+    }
+
+    memmove(parent->keys + index + 1, parent->keys + index, sizeof(void *) * (parent->count - index));
+    memmove(parent->values + index + 2, parent->values + index + 1, sizeof(void *) * (parent->count - index));
+    parent->keys[index] = separator;
+    parent->values[index + 1] = sibling;
+    parent->count++;
+
+    return true;
+}
+
+bool sbtree_insert(sbtree * const t, void * const key, int (*key_func)(void *key, void *node_key), void * const data)
+{
+    if (t->root == NULL)
+    {
+        if ((t->root = sbtree__node_new(true)) == NULL)
+        {
+            return false;
+        }
+    }
+
+    if (t->root->count == SBTREE_NODE_KEYS)
+    {
+        sbtree_node *new_root = sbtree__node_new(false);
+        if (new_root == NULL)
+        {
+            return false;
+        }
+
+        new_root->values[0] = t->root;
+        if (!sbtree__split_child(new_root, 0))
+        {
+            SBTREE_FREE(new_root);
+            return false;
+        }
+        t->root = new_root;
+    }
+
+    sbtree_node *node = t->root;
+    while (!node->leaf)
+    {
+        unsigned int index = sbtree__child_index(node, key, key_func);
+        if (sbtree__child(node, index)->count == SBTREE_NODE_KEYS)
+        {
+            if (!sbtree__split_child(node, index))
+            {
+                return false;
+            }
+            if (key_func(key, node->keys[index]) >= 0)
+            {
+                index++;
+            }
+        }
+        node = sbtree__child(node, index);
+    }
+
+    unsigned int index = sbtree__lower_bound(node, key, key_func);
+    if (index < node->count && key_func(key, node->keys[index]) == 0)
+    {
+        return false;
+    }
+
+    memmove(node->keys + index + 1, node->keys + index, sizeof(void *) * (node->count - index));
+    memmove(node->values + index + 1, node->values + index, sizeof(void *) * (node->count - index));
+    node->keys[index] = key;
+    node->values[index] = data;
+    node->count++;
+    t->length++;
+
+    return true;
+}
+
+void **sbtree_search(sbtree const * const t, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    sbtree_node *leaf = sbtree__find_leaf(t, key, key_func);
+    if (leaf == NULL)
+    {
+        return NULL;
+    }
+
+    unsigned int index = sbtree__lower_bound(leaf, key, key_func);
+    if (index < leaf->count && key_func(key, leaf->keys[index]) == 0)
+    {
+        return &leaf->values[index];
+    }
+    return NULL;
+}
+
+static void sbtree__borrow_left(sbtree_node * const parent, unsigned int const index)
+{
+    sbtree_node *child = sbtree__child(parent, index);
+    sbtree_node *left = sbtree__child(parent, index - 1);
+
+    memmove(child->keys + 1, child->keys, sizeof(void *) * child->count);
+    if (child->leaf)
+    {
+        memmove(child->values + 1, child->values, sizeof(void *) * child->count);
+        child->keys[0] = left->keys[left->count - 1];
+        child->values[0] = left->values[left->count - 1];
+        parent->keys[index - 1] = child->keys[0];
+    }
+    else
+    {
+        memmove(child->values + 1, child->values, sizeof(void *) * (child->count + 1));
+        child->keys[0] = parent->keys[index - 1];
+        child->values[0] = left->values[left->count];
+        parent->keys[index - 1] = left->keys[left->count - 1];
+    }
+
+    left->count--;
+    child->count++;
+}
+
+static void sbtree__borrow_right(sbtree_node * const parent, unsigned int const index)
+{
+    sbtree_node *child = sbtree__child(parent, index);
+    sbtree_node *right = sbtree__child(parent, index + 1);
+
+    if (child->leaf)
+    {
+        child->keys[child->count] = right->keys[0];
+        child->values[child->count] = right->values[0];
+        memmove(right->values, right->values + 1, sizeof(void *) * (right->count - 1));
+        memmove(right->keys, right->keys + 1, sizeof(void *) * (right->count - 1));
+        parent->keys[index] = right->keys[0];
+    }
+    else
+    {
+        child->keys[child->count] = parent->keys[index];
+        child->values[child->count + 1] = right->values[0];
+        parent->keys[index] = right->keys[0];
+        memmove(right->values, right->values + 1, sizeof(void *) * right->count);
+        memmove(right->keys, right->keys + 1, sizeof(void *) * (right->count - 1));
+    }
+
+    right->count--;
+    child->count++;
+}
+
+/* merges the child at `index + 1` into the child at `index` */
+static void sbtree__merge(sbtree_node * const parent, unsigned int const index)
+{
+    sbtree_node *left = sbtree__child(parent, index);
+    sbtree_node *right = sbtree__child(parent, index + 1);
+
+    if (left->leaf)
+    {
+        memcpy(left->keys + left->count, right->keys, sizeof(void *) * right->count);
+        memcpy(left->values + left->count, right->values, sizeof(void *) * right->count);
+        left->count += right->count;
+
+        left->next = right->next;
+        if (left->next != NULL)
+        {
+            left->next->prev = left;
+        }
+    }
+    else
+    {
+        /* the separator moves down between the two key arrays */
+        left->keys[left->count] = parent->keys[index];
+        memcpy(left->keys + left->count + 1, right->keys, sizeof(void *) * right->count);
+        memcpy(left->values + left->count + 1, right->values, sizeof(void *) * (right->count + 1));
+        left->count += right->count + 1;
+    }
+
+    memmove(parent->keys + index, parent->keys + index + 1, sizeof(void *) * (parent->count - index - 1));
+    memmove(parent->values + index + 1, parent->values + index + 2, sizeof(void *) * (parent->count - index - 1));
+    parent->count--;
+
+    SBTREE_FREE(right);
+}
+
+/* makes sure the child at `*index` can lose a key, `*index` is updated if it's merged to the left */
+static void sbtree__fill_child(sbtree_node * const parent, unsigned int * const index)
+{
+    unsigned int const i = *index;
+    if (i > 0 && sbtree__child(parent, i - 1)->count > SBTREE__MIN_KEYS)
+    {
+        sbtree__borrow_left(parent, i);
+    }
+    else if (i < parent->count && sbtree__child(parent, i + 1)->count > SBTREE__MIN_KEYS)
+    {
+        sbtree__borrow_right(parent, i);
+    }
+    else if (i < parent->count)
+    {
+        sbtree__merge(parent, i);
+    }
+    else
+    {
+        sbtree__merge(parent, i - 1);
+        *index = i - 1;
+    }
+}
+
+bool sbtree_remove(sbtree * const t, void * const key, int (*key_func)(void *searched_key, void *node_key),
+                   void (*free_func)(void *key, void *data))
+{
+    if (t->root == NULL)
+    {
+        return false;
+    }
+
+    /* the separator equal to the removed key if it's the smallest key of a subtree */
+    sbtree_node *separator_node = NULL;
+    unsigned int separator_index = 0;
+
+    sbtree_node *node = t->root;
+    while (!node->leaf)
+    {
+        unsigned int index = sbtree__child_index(node, key, key_func);
+        if (sbtree__child(node, index)->count <= SBTREE__MIN_KEYS)
+        {
+            sbtree__fill_child(node, &index);
+            if (node->count == 0)
+            {
+                /* the root lost its last key, its only child becomes the root */
+                t->root = sbtree__child(node, 0);
+                SBTREE_FREE(node);
+                node = t->root;
+                continue;
+            }
+        }
+
+        if (index > 0)
+        {
+            separator_node = node;
+            separator_index = index - 1;
+        }
+        node = sbtree__child(node, index);
+    }
+
+    unsigned int index = sbtree__lower_bound(node, key, key_func);
+    if (index == node->count || key_func(key, node->keys[index]) != 0)
+    {
+        return false;
+    }
+
+    free_func(node->keys[index], node->values[index]);
+    memmove(node->keys + index, node->keys + index + 1, sizeof(void *) * (node->count - index - 1));
+    memmove(node->values + index, node->values + index + 1, sizeof(void *) * (node->count - index - 1));
+    node->count--;
+    t->length--;
+
+    if (node->count == 0)
+    {
+        /* only the root leaf can become empty */
+        SBTREE_FREE(node);
+        t->root = NULL;
+    }
+    else if (index == 0 && separator_node != NULL)
+    {
+        separator_node->keys[separator_index] = node->keys[0];
+    }
+
+    return true;
+}
+
+sbtree_iter sbtree_begin(sbtree const * const t)
+{
+    sbtree_node *node = t->root;
+    while (node != NULL && !node->leaf)
+    {
+        node = sbtree__child(node, 0);
+    }
+
+    sbtree_iter it = {
+        .node = node,
+        .index = 0,
+    };
+    return it;
+}
+
+void sbtree_next(sbtree_iter * const it)
+{
+    if (++it->index == it->node->count)
+    {
+        it->node = it->node->next;
+        it->index = 0;
+    }
+}
+
+void *sbtree_key(sbtree_iter const it)
+{
+    return it.node->keys[it.index];
+}
+
+void *sbtree_data(sbtree_iter const it)
+{
+    return it.node->values[it.index];
+}
+
+sbtree_iter sbtree_lower_bound(sbtree const * const t, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    sbtree_iter it = {
+        .node = sbtree__find_leaf(t, key, key_func),
+        .index = 0,
+    };
+    if (it.node == NULL)
+    {
+        return it;
+    }
+
+    it.index = sbtree__lower_bound(it.node, key, key_func);
+    if (it.index == it.node->count)
+    {
+        it.node = it.node->next;
+        it.index = 0;
+    }
+    return it;
+}
+
+size_t sbtree_range(sbtree const * const t, void * const lo, void * const hi,
+                    int (*key_func)(void *searched_key, void *node_key),
+                    void (*callback)(void *key, void *data, void *ctx), void *ctx)
+{
+    size_t visited = 0;
+    for (sbtree_iter it = sbtree_lower_bound(t, lo, key_func); it.node != NULL; sbtree_next(&it))
+    {
+        if (key_func(hi, sbtree_key(it)) <= 0)
+        {
+            break;
+        }
+        callback(sbtree_key(it), sbtree_data(it), ctx);
+        visited++;
+    }
+    return visited;
+}
+
+#endif /*SBTREE_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
@@ -0,0 +1,712 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     #define SCMAP_MALLOC(size) malloc(size)
+ *     #define SCMAP_FREE(ptr)    free(ptr)
+ *
+ *         These defines only need to be set in the file containing
+ *         #define SCMAP_IMPLEMENTATION.
+ *
+ *         By default, scmap uses stdlib malloc() and free() for memory
+ *         management. You can substitute your own functions instead by defining
+ *         these symbols. You must either define both, or neither.
+ *
+ *     #define SCMAP_MAX_READERS 64
+ *
+ *         Maximum number of concurrently registered reader threads.
+ *
+ *     #define SCMAP_CACHE_LINE 64
+ *
+ *         Alignment used to keep the reader slots on separate cache lines.
+ *
+ * Concurrent ordered map for read-mostly workloads using C11 atomics and
+ * POSIX threads. It is an AVL tree whose published nodes are never modified:
+ * a writer copies the nodes on the path it changes and publishes the new root
+ * with a single atomic store. Readers take no locks and always see a
+ * consistent version of the whole tree. Writers are serialized by a mutex.
+ *
+ * Replaced nodes are reclaimed with epochs. Each reader announces the epoch in
+ * which it entered a read section, and a node retired in an earlier epoch is
+ * freed once no reader is still in it. Keys are compared by a `key_func` with
+ * the same convention as in sbintree. The structs hold `_Atomic` members, so
+ * the header is C11 only and cannot be included from C++.
+ */
+
+#ifndef INCLUDE_SCMAP_H
+#define INCLUDE_SCMAP_H
+
+#ifdef __cplusplus
+#error "scmap.h requires C11 atomics (<stdatomic.h>, _Atomic, _Alignas) and cannot be compiled as C++."
+#endif
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(SCMAP_MALLOC) && !defined(SCMAP_FREE) || !defined(SCMAP_MALLOC) && defined(SCMAP_FREE)
+#error "You must define both SCMAP_MALLOC and SCMAP_FREE, or neither."
+#endif
+#if !defined(SCMAP_MALLOC) && !defined(SCMAP_FREE)
+#include <stdlib.h>
+#define SCMAP_MALLOC(size) malloc(size)
+#define SCMAP_FREE(ptr) free(ptr)
+#endif
+
+#if !defined(SCMAP_MAX_READERS)
+#define SCMAP_MAX_READERS 64
+#endif
+
+#if !defined(SCMAP_CACHE_LINE)
+#define SCMAP_CACHE_LINE 64
+#endif
+
+typedef struct scmap_node
+{
+    struct scmap_node *left;
+    struct scmap_node *right;
+    void *key;
+    void *data;
+    /* retired list or the writer's spare nodes */
+    struct scmap_node *next;
+    /* epoch of the update which created the node, or retired it once it's on the retired list */
+    uint64_t epoch;
+    int height;
+    /* the entry was removed, so its key and data are released with the node */
+    bool removed;
+} scmap_node;
+
+typedef struct
+{
+    /* epoch in which the reader entered its read section, 0 outside of it */
+    _Alignas(SCMAP_CACHE_LINE) _Atomic uint64_t epoch;
+    atomic_bool used;
+} scmap_reader;
+
+typedef struct
+{
+    _Alignas(SCMAP_CACHE_LINE) _Atomic(scmap_node *) root;
+    _Atomic uint64_t epoch;
+    scmap_reader readers[SCMAP_MAX_READERS];
+    /* writer side, protected by the mutex */
+    _Alignas(SCMAP_CACHE_LINE) pthread_mutex_t lock;
+    scmap_node *retired_first;
+    scmap_node *retired_last;
+    scmap_node *spare;
+    size_t spare_count;
+    size_t length;
+    void (*free_func)(void *key, void *data);
+} scmap;
+
+/**
+ * Initializes an empty map.
+ *
+ * @param map Map to initialize.
+ * @param free_func Called with the key and data of a removed entry once no
+ * reader can see it anymore.
+ * @return `true` upon success, `false` if the mutex cannot be initialized.
+ */
+bool scmap_init(scmap * const map, void (*free_func)(void *key, void *data));
+
+/* releases all entries with the free_func and frees the nodes, no other thread may use the map anymore */
+void scmap_destroy(scmap * const map);
+void scmap_dummy_free(void *key, void *data);
+
+/**
+ * Claims a reader slot for the calling thread.
+ *
+ * @param map Map to read.
+ * @return Reader id for scmap_read_begin and scmap_read_end or
+ * `SCMAP_MAX_READERS` if all slots are taken.
+ */
+size_t scmap_reader_register(scmap * const map);
+void scmap_reader_unregister(scmap * const map, size_t const reader);
+
+/**
+ * Starts a read section. Nodes, keys and data seen inside it stay valid until
+ * the matching scmap_read_end. Read sections must not be nested.
+ */
+void scmap_read_begin(scmap * const map, size_t const reader);
+void scmap_read_end(scmap * const map, size_t const reader);
+
+/**
+ * Finds a key, must be called inside a read section.
+ *
+ * @param map Map to search.
+ * @param key Searched key.
+ * @param key_func Comparison function.
+ * @param data Set to the data of the key if found, can be `NULL`.
+ * @return `true` if the key is present.
+ */
+bool scmap_get(scmap * const map, void * const key, int (*key_func)(void *searched_key, void *node_key), void ** const data);
+
+/**
+ * Calls `callback` for every key in the range [lo, hi) in order, must be
+ * called inside a read section.
+ *
+ * @return Number of visited keys.
+ */
+size_t scmap_range(scmap * const map, void * const lo, void * const hi,
+                   int (*key_func)(void *searched_key, void *node_key),
+                   void (*callback)(void *key, void *data, void *ctx), void *ctx);
+
+/**
+ * Inserts a key. Can be called from any thread, writers are serialized.
+ *
+ * @return `true` upon success, `false` if the key is already present or on
+ * allocation failure.
+ */
+bool scmap_insert(scmap * const map, void * const key, int (*key_func)(void *key, void *node_key), void * const data);
+
+/**
+ * Removes a key. Its key and data are passed to the `free_func` of the map
+ * once no reader can see them anymore.
+ *
+ * @return `true` if the key was found and removed.
+ */
+bool scmap_remove(scmap * const map, void * const key, int (*key_func)(void *searched_key, void *node_key));
+
+/* frees the retired nodes which no reader can see anymore */
+void scmap_reclaim(scmap * const map);
+
+#endif /*INCLUDE_SCMAP_H*/
+
+#ifdef SCMAP_IMPLEMENTATION
+
+/* tallest AVL tree which fits into 64-bit memory */
+#define SCMAP__MAX_HEIGHT 92
+
+bool scmap_init(scmap * const map, void (*free_func)(void *key, void *data))
+{
+    if (pthread_mutex_init(&map->lock, NULL) != 0)
+    {
+        return false;
+    }
+
+    atomic_init(&map->root, NULL);
+    /* 0 marks a reader outside of a read section */
+    atomic_init(&map->epoch, 1);
+    for (size_t i = 0; i < SCMAP_MAX_READERS; i++)
+    {
+        atomic_init(&map->readers[i].epoch, 0);
+        atomic_init(&map->readers[i].used, false);
+    }
+
+    map->retired_first = NULL;
+    map->retired_last = NULL;
+    map->spare = NULL;
+    map->spare_count = 0;
+    map->length = 0;
+    map->free_func = free_func;
+
+    return true;
+}
+
+static void scmap__free_list(scmap * const map, scmap_node *node)
+{
+    while (node != NULL)
+    {
+        scmap_node *next = node->next;
+        if (node->removed)
+        {
+            map->free_func(node->key, node->data);
+        }
+        SCMAP_FREE(node);
+        node = next;
+    }
+}
+
+static void scmap__free_tree(scmap * const map, scmap_node * const node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    scmap__free_tree(map, node->left);
+    scmap__free_tree(map, node->right);
+    map->free_func(node->key, node->data);
+    SCMAP_FREE(node);
+}
+
+void scmap_destroy(scmap * const map)
+{
+    scmap__free_tree(map, atomic_load(&map->root));
+    scmap__free_list(map, map->retired_first);
+    scmap__free_list(map, map->spare);
+    pthread_mutex_destroy(&map->lock);
+
+    atomic_store(&map->root, NULL);
+    map->retired_first = NULL;
+    map->retired_last = NULL;
+    map->spare = NULL;
+    map->spare_count = 0;
+    map->length = 0;
+}
+
+void scmap_dummy_free(void *key, void *data)
+{
+    (void) key;
+    (void) data;
+}
+
+size_t scmap_reader_register(scmap * const map)
+{
+    for (size_t i = 0; i < SCMAP_MAX_READERS; i++)
+    {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&map->readers[i].used, &expected, true))
+        {
+            return i;
+        }
+    }
+    return SCMAP_MAX_READERS;
+}
+
+void scmap_reader_unregister(scmap * const map, size_t const reader)
+{
+    atomic_store(&map->readers[reader].epoch, 0);
+    atomic_store(&map->readers[reader].used, false);
+}
+
+void scmap_read_begin(scmap * const map, size_t const reader)
+{
+    /*
+     * sequentially consistent, so either the writer sees this epoch when it
+     * scans the readers or this reader sees the root published before the scan
+     */
+    atomic_store(&map->readers[reader].epoch, atomic_load(&map->epoch));
+}
+
+void scmap_read_end(scmap * const map, size_t const reader)
+{
+    atomic_store_explicit(&map->readers[reader].epoch, 0, memory_order_release);
+}
+
+bool scmap_get(scmap * const map, void * const key, int (*key_func)(void *searched_key, void *node_key), void ** const data)
+{
+    scmap_node *current = atomic_load(&map->root);
+    while (current != NULL)
+    {
+        int cmp = key_func(key, current->key);
+        /* left subtree */
+        if (cmp < 0)
+        {
+            current = current->left;
+        }
+        /* right subtree */
+        else if (cmp > 0)
+        {
+            current = current->right;
+        }
+        else
+        {
+            if (data != NULL)
+            {
+                *data = current->data;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t scmap__range(scmap_node * const node, void * const lo, void * const hi,
+                           int (*key_func)(void *searched_key, void *node_key),
+                           void (*callback)(void *key, void *data, void *ctx), void *ctx)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+
+    size_t visited = 0;
+    bool above_lo = key_func(lo, node->key) <= 0;
+    bool below_hi = key_func(hi, node->key) > 0;
+    if (above_lo)
+    {
+        visited += scmap__range(node->left, lo, hi, key_func, callback, ctx);
+    }
+    if (above_lo && below_hi)
+    {
+        callback(node->key, node->data, ctx);
+        visited++;
+    }
+    if (below_hi)
+    {
+        visited += scmap__range(node->right, lo, hi, key_func, callback, ctx);
+    }
+    return visited;
+}
+
+size_t scmap_range(scmap * const map, void * const lo, void * const hi,
+                   int (*key_func)(void *searched_key, void *node_key),
+                   void (*callback)(void *key, void *data, void *ctx), void *ctx)
+{
+    return scmap__range(atomic_load(&map->root), lo, hi, key_func, callback, ctx);
+}
+
+/* makes sure the writer has enough spare nodes for one update, so it cannot fail halfway */
+static bool scmap__reserve_spare(scmap * const map)
+{
+    /* the copied path, up to two rotated nodes per level and the new node */
+    size_t const needed = 3 * SCMAP__MAX_HEIGHT + 1;
+    while (map->spare_count < needed)
+    {
+        scmap_node *node = (scmap_node *) SCMAP_MALLOC(sizeof(scmap_node));
+        if (node == NULL)
+        {
+            return false;
+        }
+        node->next = map->spare;
+        node->removed = false;
+        map->spare = node;
+        map->spare_count++;
+    }
+    return true;
+}
+
+static scmap_node *scmap__new_node(scmap * const map, void * const key, void * const data, scmap_node * const left,
+                                   scmap_node * const right, int const height)
+{
+    scmap_node *node = map->spare;
+    map->spare = node->next;
+    map->spare_count--;
+
+    node->left = left;
+    node->right = right;
+    node->key = key;
+    node->data = data;
+    node->next = NULL;
+    node->epoch = atomic_load_explicit(&map->epoch, memory_order_relaxed);
+    node->height = height;
+    node->removed = false;
+
+    return node;
+}
+
+static void scmap__retire(scmap * const map, scmap_node * const node, bool const removed)
+{
+    node->next = NULL;
+    node->epoch = atomic_load_explicit(&map->epoch, memory_order_relaxed);
+    node->removed = removed;
+
+    if (map->retired_last == NULL)
+    {
+        map->retired_first = node;
+    }
+    else
+    {
+        map->retired_last->next = node;
+    }
+    map->retired_last = node;
+}
+
+/* returns a node which the current update may modify, copying a published one */
+static scmap_node *scmap__own(scmap * const map, scmap_node * const node)
+{
+    if (node->epoch == atomic_load_explicit(&map->epoch, memory_order_relaxed))
+    {
+        return node;
+    }
+
+    scmap_node *copy = scmap__new_node(map, node->key, node->data, node->left, node->right, node->height);
+    scmap__retire(map, node, false);
+    return copy;
+}
+
+static int scmap__height(scmap_node * const node)
+{
+    return node == NULL ? 0 : node->height;
+}
+
+static void scmap__update_height(scmap_node * const node)
+{
+    int left = scmap__height(node->left);
+    int right = scmap__height(node->right);
+    node->height = (left > right ? left : right) + 1;
+}
+
+/* the node must be owned, returns the new subtree root */
+static scmap_node *scmap__rotate_left(scmap * const map, scmap_node * const node)
+{
+    scmap_node *pivot = scmap__own(map, node->right);
+    node->right = pivot->left;
+    pivot->left = node;
+    scmap__update_height(node);
+    scmap__update_height(pivot);
+    return pivot;
+}
+
+static scmap_node *scmap__rotate_right(scmap * const map, scmap_node * const node)
+{
+    scmap_node *pivot = scmap__own(map, node->left);
+    node->left = pivot->right;
+    pivot->right = node;
+    scmap__update_height(node);
+    scmap__update_height(pivot);
+    return pivot;
+}
+
+static scmap_node *scmap__rebalance(scmap * const map, scmap_node * const node)
+{
+    int balance = scmap__height(node->left) - scmap__height(node->right);
+    if (balance > 1)
+    {
+        if (scmap__height(node->left->left) < scmap__height(node->left->right))
+        {
+            node->left = scmap__rotate_left(map, scmap__own(map, node->left));
+        }
+        return scmap__rotate_right(map, node);
+    }
+    else if (balance < -1)
+    {
+        if (scmap__height(node->right->right) < scmap__height(node->right->left))
+        {
+            node->right = scmap__rotate_right(map, scmap__own(map, node->right));
+        }
+        return scmap__rotate_left(map, node);
+    }
+
+    scmap__update_height(node);
+    return node;
+}
+
+static scmap_node *scmap__insert(scmap * const map, scmap_node * const node, void * const key,
+                                 int (*key_func)(void *key, void *node_key), void * const data, bool * const inserted)
+{
+    if (node == NULL)
+    {
+        *inserted = true;
+        return scmap__new_node(map, key, data, NULL, NULL, 1);
+    }
+
+    int cmp = key_func(key, node->key);
+    if (cmp == 0)
+    {
+        return node;
+    }
+
+    scmap_node *child = scmap__insert(map, cmp < 0 ? node->left : node->right, key, key_func, data, inserted);
+    if (!*inserted)
+    {
+        return node;
+    }
+
+    scmap_node *owned = scmap__own(map, node);
+    if (cmp < 0)
+    {
+        owned->left = child;
+    }
+    else
+    {
+        owned->right = child;
+    }
+    return scmap__rebalance(map, owned);
+}
+
+static scmap_node *scmap__remove_min(scmap * const map, scmap_node * const node, scmap_node ** const min)
+{
+    if (node->left == NULL)
+    {
+        *min = node;
+        return node->right;
+    }
+
+    scmap_node *owned = scmap__own(map, node);
+    owned->left = scmap__remove_min(map, owned->left, min);
+    return scmap__rebalance(map, owned);
+}
+
+static scmap_node *scmap__remove(scmap * const map, scmap_node * const node, void * const key,
+                                 int (*key_func)(void *searched_key, void *node_key), bool * const removed)
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    int cmp = key_func(key, node->key);
+    if (cmp == 0)
+    {
+        *removed = true;
+        scmap__retire(map, node, true);
+        if (node->left == NULL)
+        {
+            return node->right;
+        }
+        if (node->right == NULL)
+        {
+            return node->left;
+        }
+
+        /* the successor takes the place of the node as a new copy */
+        scmap_node *min;
+        scmap_node *right = scmap__remove_min(map, node->right, &min);
+        scmap_node *replacement = scmap__new_node(map, min->key, min->data, node->left, right, 0);
+        scmap__retire(map, min, false);
+        return scmap__rebalance(map, replacement);
+    }
+
+    scmap_node *child = scmap__remove(map, cmp < 0 ? node->left : node->right, key, key_func, removed);
+    if (!*removed)
+    {
+        return node;
+    }
+
+    scmap_node *owned = scmap__own(map, node);
+    if (cmp < 0)
+    {
+        owned->left = child;
+    }
+    else
+    {
+        owned->right = child;
+    }
+    return scmap__rebalance(map, owned);
+}
+
+static void scmap__reclaim(scmap * const map)
+{
+    uint64_t oldest = UINT64_MAX;
+    for (size_t i = 0; i < SCMAP_MAX_READERS; i++)
+    {
+        uint64_t epoch = atomic_load(&map->readers[i].epoch);
+        if (epoch != 0 && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    /* nodes retired in an epoch older than every active reader are unreachable */
+    while (map->retired_first != NULL && map->retired_first->epoch < oldest)
+    {
+        scmap_node *node = map->retired_first;
+        map->retired_first = node->next;
+        if (node->removed)
+        {
+            map->free_func(node->key, node->data);
+        }
+        SCMAP_FREE(node);
+    }
+
+    if (map->retired_first == NULL)
+    {
+        map->retired_last = NULL;
+    }
+}
+
+static void scmap__publish(scmap * const map, scmap_node * const root)
+{
+    atomic_store(&map->root, root);
+    /* readers entering from now on can only see the new root */
+    atomic_fetch_add(&map->epoch, 1);
+    scmap__reclaim(map);
+}
+
+bool scmap_insert(scmap * const map, void * const key, int (*key_func)(void *key, void *node_key), void * const data)
+{
+    pthread_mutex_lock(&map->lock);
+    if (!scmap__reserve_spare(map))
+    {
+        pthread_mutex_unlock(&map->lock);
+        return false;
+    }
+
+    bool inserted = false;
+    scmap_node *root = scmap__insert(map, atomic_load_explicit(&map->root, memory_order_relaxed), key, key_func, data,
+                                     &inserted);
+    if (inserted)
+    {
+        map->length++;
+        scmap__publish(map, root);
+    }
+
+    pthread_mutex_unlock(&map->lock);
+    return inserted;
+}
+
+bool scmap_remove(scmap * const map, void * const key, int (*key_func)(void *searched_key, void *node_key))
+{
+    pthread_mutex_lock(&map->lock);
+    if (!scmap__reserve_spare(map))
+    {
+        pthread_mutex_unlock(&map->lock);
+        return false;
+    }
+
+    bool removed = false;
+    scmap_node *root = scmap__remove(map, atomic_load_explicit(&map->root, memory_order_relaxed), key, key_func,
+                                     &removed);
+    if (removed)
+    {
+        map->length--;
+        scmap__publish(map, root);
+    }
+
+    pthread_mutex_unlock(&map->lock);
+    return removed;
+}
+
+void scmap_reclaim(scmap * const map)
+{
+    pthread_mutex_lock(&map->lock);
+    scmap__reclaim(map);
+    pthread_mutex_unlock(&map->lock);
+}
+
+#endif /*SCMAP_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
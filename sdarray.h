@@ -15,6 +15,14 @@
  *         By default, sdarray uses stdlib realloc() and free() for memory
  *         management. You can substitute your own functions instead by defining
  *         these symbols. You must either define both, or neither.
+ *
+ *     #define SDARRAY_THREADS
+ *     #define SDARRAY_PARALLEL_SORT_THRESHOLD 65536
+ *
+ *         Define SDARRAY_THREADS to enable sdarray_parallel_sort(), which
+ *         requires POSIX threads (link with `-pthread`). Arrays shorter than
+ *         SDARRAY_PARALLEL_SORT_THRESHOLD elements are sorted by a single
+ *         thread.
  */
 
 #ifndef INCLUDE_SDARRAY_H
@@ -33,6 +41,10 @@
 #define SDARRAY_FREE(ptr) free(ptr)
 #endif
 
+#if !defined(SDARRAY_PARALLEL_SORT_THRESHOLD)
+#define SDARRAY_PARALLEL_SORT_THRESHOLD 65536
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -46,11 +58,100 @@ typedef struct
     size_t element_size;
 } sdarray;
 
+/**
+ * Key types supported by `sdarray_radix_sort`.
+ */
+typedef enum
+{
+    SDARRAY_RADIX_U32,
+    SDARRAY_RADIX_I32,
+    SDARRAY_RADIX_F32,
+    SDARRAY_RADIX_U64,
+    SDARRAY_RADIX_I64,
+    SDARRAY_RADIX_F64,
+} sdarray_radix_key;
+
 sdarray sdarray_new(size_t const element_size, size_t const init_capacity);
 sdarray sdarray_wrap_ptr(void * const ptr, size_t const element_size, size_t const ptr_size);
 bool sdarray_add_from(sdarray * const arr, const void * const src, size_t const length);
 bool sdarray_add_sdarray(sdarray * const arr, sdarray const arr2);
 bool sdarray_remove(sdarray * const arr, size_t const index);
+bool sdarray_push(sdarray * const arr, const void * const element);
+bool sdarray_pop(sdarray * const arr, void * const element);
+bool sdarray_reserve(sdarray * const arr, size_t const capacity);
+bool sdarray_shrink_to_fit(sdarray * const arr);
+
+/**
+ * Inserts `count` elements before `index`, moving the following elements back.
+ *
+ * @param arr Array to insert into.
+ * @param index Position of the first inserted element, at most `.length`.
+ * @param src Elements to insert, may point into `arr` itself, or `NULL` to
+ * leave the inserted elements uninitialized.
+ * @param count Number of inserted elements.
+ * @return `false` if `index` is out of bounds or the array cannot grow.
+ */
+bool sdarray_insert_range(sdarray * const arr, size_t const index, const void * const src, size_t const count);
+bool sdarray_erase_range(sdarray * const arr, size_t const index, size_t const count);
+bool sdarray_swap_remove(sdarray * const arr, size_t const index);
+
+/**
+ * Removes all elements for which `pred` returns `true` in a single pass while
+ * keeping the order of the remaining elements.
+ *
+ * @param arr Array to filter.
+ * @param pred Predicate called with a pointer to each element and `ctx`.
+ * @param ctx User pointer passed to `pred`.
+ * @return Number of removed elements.
+ */
+size_t sdarray_remove_if(sdarray * const arr, bool (*pred)(void *element, void *ctx), void * const ctx);
+
+/**
+ * Sorts an array of 32-bit or 64-bit integers or floats in ascending order
+ * using an LSD radix sort with 8-bit digits. Negative floats sort before
+ * positive ones, NaNs sort to the ends according to their sign bit.
+ *
+ * @param arr Array to sort, its `.element_size` must match the key type.
+ * @param key Type of the array elements.
+ * @return `false` if the element size does not match or the temporary buffer
+ * cannot be allocated, `true` otherwise.
+ */
+bool sdarray_radix_sort(sdarray * const arr, sdarray_radix_key const key);
+
+/**
+ * Finds the first element which is not less than `key` in a sorted array.
+ *
+ * @param arr Sorted array.
+ * @param key Searched key.
+ * @param cmp Comparison function with the same semantics as in `bsearch`.
+ * @return Index of the found element or `.length` if all elements are less.
+ */
+size_t sdarray_lower_bound(sdarray * const arr, const void * const key, int (*cmp)(const void *key, const void *element));
+
+/**
+ * Removes consecutive duplicates, keeping the first element of each run.
+ *
+ * @param arr Array to deduplicate, usually sorted.
+ * @param cmp Comparison function returning `0` for equal elements.
+ * @return Number of removed elements.
+ */
+size_t sdarray_unique(sdarray * const arr, int (*cmp)(const void *a, const void *b));
+
+#ifdef SDARRAY_THREADS
+/**
+ * Sorts the array with a merge sort running on up to `thread_count` threads.
+ * Each thread sorts its chunk using `qsort` and the sorted chunks are then
+ * merged pairwise. Every merge is split by output position between the
+ * threads, so the last merges also use all of them.
+ *
+ * @param arr Array to sort.
+ * @param cmp Comparison function with the same semantics as in `qsort`.
+ * @param thread_count Maximum number of threads to use.
+ * @return `false` if the temporary buffer cannot be allocated, `true`
+ * otherwise.
+ */
+bool sdarray_parallel_sort(sdarray * const arr, int (*cmp)(const void *a, const void *b), size_t const thread_count);
+#endif
 void *sdarray_at(sdarray * const arr, size_t const index);
 void sdarray_swap(sdarray *arr, sdarray *arr2);
 bool sdarray_set_capacity(sdarray * const arr, size_t const capacity);
@@ -60,10 +161,329 @@ sdarray sdarray_clone(sdarray const arr);
 }
 #endif
 
+/**
+ * Defines a typed dynamic array `name` holding elements of `type` together
+ * with its `static inline` functions `name##_new`, `name##_free`,
+ * `name##_reserve`, `name##_push`, `name##_pop`, `name##_at`, `name##_insert`,
+ * `name##_remove` and `name##_shrink_to_fit`. Unlike `sdarray`, the element
+ * size is a compile-time constant, so element copies and indexing can be
+ * inlined and vectorized.
+ *
+ * Example: `SDARRAY_DEFINE(int_array, int)` defines the type `int_array` and
+ * functions such as `bool int_array_push(int_array * const arr, int const value)`.
+ *
+ * @param name Name of the defined array type and prefix of its functions.
+ * @param type Element type.
+ */
+#define SDARRAY_DEFINE(name, type)                                                                \
+    typedef struct                                                                                \
+    {                                                                                             \
+        type *data;                                                                               \
+        size_t length;                                                                            \
+        size_t capacity;                                                                          \
+    } name;                                                                                       \
+                                                                                                  \
+    static inline name name##_new(size_t const init_capacity)                                     \
+    {                                                                                             \
+        name arr = {.data = NULL, .length = 0, .capacity = 0};                                    \
+        if (init_capacity > 0                                                                     \
+            && (arr.data = (type *) SDARRAY_REALLOC(NULL, sizeof(type) * init_capacity)) != NULL) \
+        {                                                                                         \
+            arr.capacity = init_capacity;                                                         \
+        }                                                                                         \
+        return arr;                                                                               \
+    }                                                                                             \
+                                                                                                  \
+    static inline void name##_free(name * const arr)                                              \
+    {                                                                                             \
+        SDARRAY_FREE(arr->data);                                                                  \
+        arr->data = NULL;                                                                         \
+        arr->length = 0;                                                                          \
+        arr->capacity = 0;                                                                        \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##_reserve(name * const arr, size_t const capacity)                    \
+    {                                                                                             \
+        if (capacity <= arr->capacity)                                                            \
+        {                                                                                         \
+            return true;                                                                          \
+        }                                                                                         \
+        type *data = (type *) SDARRAY_REALLOC(arr->data, sizeof(type) * capacity);                \
+        if (data == NULL)                                                                         \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        arr->data = data;                                                                         \
+        arr->capacity = capacity;                                                                 \
+        return true;                                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##__grow(name * const arr)                                             \
+    {                                                                                             \
+        size_t const new_length = arr->length + 1;                                                \
+        /* ceil(new_length * 1.5) */                                                              \
+        return name##_reserve(arr, 3 * new_length / 2 + ((new_length % 2) != 0));                 \
+    }                                                                                             \
+                                                                                                  \
+    static inline void name##__shrink(name * const arr)                                           \
+    {                                                                                             \
+        /* shrink to half of the capacity at quarter occupancy */                                 \
+        if (arr->capacity < 8 || arr->length > arr->capacity / 4)                                 \
+        {                                                                                         \
+            return;                                                                               \
+        }                                                                                         \
+        type *data = (type *) SDARRAY_REALLOC(arr->data, sizeof(type) * (arr->capacity / 2));     \
+        if (data != NULL)                                                                         \
+        {                                                                                         \
+            arr->data = data;                                                                     \
+            arr->capacity /= 2;                                                                   \
+        }                                                                                         \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##_push(name * const arr, type const value)                            \
+    {                                                                                             \
+        if (arr->length == arr->capacity && !name##__grow(arr))                                   \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        arr->data[arr->length++] = value;                                                         \
+        return true;                                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##_pop(name * const arr, type * const value)                           \
+    {                                                                                             \
+        if (arr->length == 0)                                                                     \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        arr->length--;                                                                            \
+        if (value != NULL)                                                                        \
+        {                                                                                         \
+            *value = arr->data[arr->length];                                                      \
+        }                                                                                         \
+        name##__shrink(arr);                                                                      \
+        return true;                                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline type *name##_at(name * const arr, size_t const index)                           \
+    {                                                                                             \
+        return arr->data + index;                                                                 \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##_insert(name * const arr, size_t const index, type const value)      \
+    {                                                                                             \
+        if (index > arr->length)                                                                  \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        if (arr->length == arr->capacity && !name##__grow(arr))                                   \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        memmove(arr->data + index + 1, arr->data + index,                                         \
+                sizeof(type) * (arr->length - index));                                            \
+        arr->data[index] = value;                                                                 \
+        arr->length++;                                                                            \
+        return true;                                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##_remove(name * const arr, size_t const index)                        \
+    {                                                                                             \
+        if (index >= arr->length)                                                                 \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        memmove(arr->data + index, arr->data + index + 1,                                         \
+                sizeof(type) * (arr->length - index - 1));                                        \
+        arr->length--;                                                                            \
+        name##__shrink(arr);                                                                      \
+        return true;                                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##_shrink_to_fit(name * const arr)                                     \
+    {                                                                                             \
+        if (arr->length == arr->capacity)                                                         \
+        {                                                                                         \
+            return true;                                                                          \
+        }                                                                                         \
+        if (arr->length == 0)                                                                     \
+        {                                                                                         \
+            name##_free(arr);                                                                     \
+            return true;                                                                          \
+        }                                                                                         \
+        type *data = (type *) SDARRAY_REALLOC(arr->data, sizeof(type) * arr->length);             \
+        if (data == NULL)                                                                         \
+        {                                                                                         \
+            return false;                                                                         \
+        }                                                                                         \
+        arr->data = data;                                                                         \
+        arr->capacity = arr->length;                                                              \
+        return true;                                                                              \
+    }
+
+/**
+ * Defines `static inline` functions `void name(type *data, size_t length)`
+ * sorting an array with an introsort and
+ * `size_t name##_lower_bound(type const *data, size_t length, type value)`
+ * searching a sorted array. The comparison `less(a, b)` is expanded in place,
+ * so unlike `qsort` there's no call through a function pointer per comparison.
+ *
+ * Example: `#define int_less(a, b) ((a) < (b))` and
+ * `SDARRAY_DEFINE_SORT(int_sort, int, int_less)`.
+ *
+ * @param name Name of the sorting function and prefix of the search function.
+ * @param type Element type.
+ * @param less Function or function-like macro returning non-zero if `a < b`.
+ */
+#define SDARRAY_DEFINE_SORT(name, type, less)                                                               \
+    static inline void name##__insertion(type * const data, size_t const length)                            \
+    {                                                                                                       \
+        for (size_t i = 1; i < length; i++)                                                                 \
+        {                                                                                                   \
+            type const value = data[i];                                                                     \
+            size_t j = i;                                                                                   \
+            for (; j > 0 && less(value, data[j - 1]); j--)                                                  \
+            {                                                                                               \
+                data[j] = data[j - 1];                                                                      \
+            }                                                                                               \
+            data[j] = value;                                                                                \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##__sift_down(type * const data, size_t root, size_t const length)               \
+    {                                                                                                       \
+        type const value = data[root];                                                                      \
+        for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1)                             \
+        {                                                                                                   \
+            if (child + 1 < length && less(data[child], data[child + 1]))                                   \
+            {                                                                                               \
+                child++;                                                                                    \
+            }                                                                                               \
+            if (!less(value, data[child]))                                                                  \
+            {                                                                                               \
+                break;                                                                                      \
+            }                                                                                               \
+            data[root] = data[child];                                                                       \
+            root = child;                                                                                   \
+        }                                                                                                   \
+        data[root] = value;                                                                                 \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##__heapsort(type * const data, size_t const length)                             \
+    {                                                                                                       \
+        for (size_t i = length / 2; i > 0; i--)                                                             \
+        {                                                                                                   \
+            name##__sift_down(data, i - 1, length);                                                         \
+        }                                                                                                   \
+        for (size_t i = length - 1; i > 0; i--)                                                             \
+        {                                                                                                   \
+            type const tmp = data[0];                                                                       \
+            data[0] = data[i];                                                                              \
+            data[i] = tmp;                                                                                  \
+            name##__sift_down(data, 0, i);                                                                  \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name(type *data, size_t length)                                                      \
+    {                                                                                                       \
+        size_t depth = 0;                                                                                   \
+        for (size_t n = length; n > 1; n >>= 1)                                                             \
+        {                                                                                                   \
+            depth += 2;                                                                                     \
+        }                                                                                                   \
+                                                                                                            \
+        while (length > 16)                                                                                 \
+        {                                                                                                   \
+            /* fall back to heapsort on too many bad pivots */                                              \
+            if (depth-- == 0)                                                                               \
+            {                                                                                               \
+                name##__heapsort(data, length);                                                             \
+                return;                                                                                     \
+            }                                                                                               \
+                                                                                                            \
+            /* median of three, also serves as sentinels for the partitioning */                            \
+            size_t const mid = (length - 1) / 2;                                                            \
+            type tmp;                                                                                       \
+            if (less(data[mid], data[0]))                                                                   \
+            {                                                                                               \
+                tmp = data[mid], data[mid] = data[0], data[0] = tmp;                                        \
+            }                                                                                               \
+            if (less(data[length - 1], data[mid]))                                                          \
+            {                                                                                               \
+                tmp = data[mid], data[mid] = data[length - 1], data[length - 1] = tmp;                      \
+                if (less(data[mid], data[0]))                                                               \
+                {                                                                                           \
+                    tmp = data[mid], data[mid] = data[0], data[0] = tmp;                                    \
+                }                                                                                           \
+            }                                                                                               \
+                                                                                                            \
+            type const pivot = data[mid];                                                                   \
+            size_t i = 0;                                                                                   \
+            size_t j = length - 1;                                                                          \
+            for (;;)                                                                                        \
+            {                                                                                               \
+                while (less(data[i], pivot))                                                                \
+                {                                                                                           \
+                    i++;                                                                                    \
+                }                                                                                           \
+                while (less(pivot, data[j]))                                                                \
+                {                                                                                           \
+                    j--;                                                                                    \
+                }                                                                                           \
+                if (i >= j)                                                                                 \
+                {                                                                                           \
+                    break;                                                                                  \
+                }                                                                                           \
+                tmp = data[i], data[i] = data[j], data[j] = tmp;                                            \
+                i++;                                                                                        \
+                j--;                                                                                        \
+            }                                                                                               \
+                                                                                                            \
+            /* recurse into the smaller part and loop on the larger one */                                  \
+            size_t const left = j + 1;                                                                      \
+            if (left < length - left)                                                                       \
+            {                                                                                               \
+                name(data, left);                                                                           \
+                data += left;                                                                               \
+                length -= left;                                                                             \
+            }                                                                                               \
+            else                                                                                            \
+            {                                                                                               \
+                name(data + left, length - left);                                                           \
+                length = left;                                                                              \
+            }                                                                                               \
+        }                                                                                                   \
+                                                                                                            \
+        name##__insertion(data, length);                                                                    \
+    }                                                                                                       \
+                                                                                                            \
+    static inline size_t name##_lower_bound(type const * const data, size_t const length, type const value) \
+    {                                                                                                       \
+        size_t low = 0;                                                                                     \
+        size_t high = length;                                                                               \
+        while (low < high)                                                                                  \
+        {                                                                                                   \
+            size_t const mid = low + (high - low) / 2;                                                      \
+            if (less(data[mid], value))                                                                     \
+            {                                                                                               \
+                low = mid + 1;                                                                              \
+            }                                                                                               \
+            else                                                                                            \
+            {                                                                                               \
+                high = mid;                                                                                 \
+            }                                                                                               \
+        }                                                                                                   \
+        return low;                                                                                         \
+    }
+
 #endif /*INCLUDE_SDARRAY_H*/
 
 #ifdef SDARRAY_IMPLEMENTATION
 
+#ifdef SDARRAY_THREADS
+#include <pthread.h>
+#endif
+
 sdarray sdarray_new(size_t const element_size, size_t const init_capacity)
 {
     sdarray arr = {.data = NULL, .length = 0, .capacity = 0, .element_size = element_size};
@@ -127,6 +547,30 @@ bool sdarray_add_sdarray(sdarray * const arr, sdarray const arr2)
     return sdarray_add_from(arr, arr2.data, arr2.length);
 }
 
+static void sdarray__shrink(sdarray * const arr)
+{
+    /* shrink to half of the capacity at quarter occupancy, so alternating
+     * push and remove around the threshold does not realloc every time */
+    size_t new_capacity = arr->capacity;
+    while (new_capacity >= 8 && arr->length <= new_capacity / 4)
+    {
+        new_capacity /= 2;
+    }
+
+    if (new_capacity == arr->capacity)
+    {
+        return;
+    }
+
+    void *data = SDARRAY_REALLOC(arr->data, sizeof(uint8_t) * arr->element_size * new_capacity);
+    /* keep the old buffer if the shrinking fails */
+    if (data != NULL)
+    {
+        arr->data = data;
+        arr->capacity = new_capacity;
+    }
+}
+
 bool sdarray_remove(sdarray * const arr, size_t const index)
 {
     if (index >= arr->length)
@@ -136,29 +580,641 @@ bool sdarray_remove(sdarray * const arr, size_t const index)
 
     if (index + 1 == arr->length)
     {
-        memset(((uint8_t *) arr->data) + index, 0, arr->element_size);
+        memset(((uint8_t *) arr->data) + index * arr->element_size, 0, arr->element_size);
     }
     else
     {
         memmove(((uint8_t *) arr->data) + index * arr->element_size,
                 ((uint8_t *) arr->data) + (index + 1) * arr->element_size,
-                sizeof(uint8_t) * arr->element_size * (arr->length - index));
+                sizeof(uint8_t) * arr->element_size * (arr->length - index - 1));
     }
     arr->length--;
 
-    /* shrink the array when it reaches cap = 2 * len */
-    if (arr->capacity / arr->length >= 2)
+    sdarray__shrink(arr);
+
+    return true;
+}
+
+bool sdarray_push(sdarray * const arr, const void * const element)
+{
+    if (arr->length == arr->capacity)
     {
-        if ((arr->data = (uint8_t *) SDARRAY_REALLOC(arr->data, sizeof(uint8_t) * arr->element_size * arr->length)) == NULL)
+        size_t const new_length = arr->length + 1;
+        /* ceil(new_length * 1.5) */
+        if (!sdarray_reserve(arr, 3 * new_length / 2 + ((new_length % 2) != 0)))
         {
             return false;
         }
-        arr->capacity = arr->length;
     }
 
+    memcpy(((uint8_t *) arr->data) + arr->length * arr->element_size, element, arr->element_size);
+    arr->length++;
+
+    return true;
+}
+
+bool sdarray_pop(sdarray * const arr, void * const element)
+{
+    if (arr->length == 0)
+    {
+        return false;
+    }
+
+    arr->length--;
+    if (element != NULL)
+    {
+        memcpy(element, ((uint8_t *) arr->data) + arr->length * arr->element_size, arr->element_size);
+    }
+
+    sdarray__shrink(arr);
+
+    return true;
+}
+
+bool sdarray_reserve(sdarray * const arr, size_t const capacity)
+{
+    if (capacity <= arr->capacity)
+    {
+        return true;
+    }
+
+    void *data = SDARRAY_REALLOC(arr->data, sizeof(uint8_t) * arr->element_size * capacity);
+    if (data == NULL)
+    {
+        return false;
+    }
+    arr->data = data;
+    arr->capacity = capacity;
+
+    return true;
+}
+
+bool sdarray_shrink_to_fit(sdarray * const arr)
+{
+    if (arr->length == arr->capacity)
+    {
+        return true;
+    }
+
+    if (arr->length == 0)
+    {
+        SDARRAY_FREE(arr->data);
+        arr->data = NULL;
+        arr->capacity = 0;
+        return true;
+    }
+
+    void *data = SDARRAY_REALLOC(arr->data, sizeof(uint8_t) * arr->element_size * arr->length);
+    if (data == NULL)
+    {
+        return false;
+    }
+    arr->data = data;
+    arr->capacity = arr->length;
+
+    return true;
+}
+
+bool sdarray_insert_range(sdarray * const arr, size_t const index, const void * const src, size_t const count)
+{
+    if (index > arr->length)
+    {
+        return false;
+    }
+
+    /* src may point into the array, keep its offset across the realloc */
+    uintptr_t const begin = (uintptr_t) arr->data;
+    bool const aliased = src != NULL && arr->data != NULL && (uintptr_t) src >= begin
+                         && (uintptr_t) src < begin + arr->element_size * arr->length;
+    size_t const offset = aliased ? (size_t) ((uintptr_t) src - begin) : 0;
+
+    size_t const new_length = arr->length + count;
+    if (new_length > arr->capacity)
+    {
+        /* ceil(new_length * 1.5) */
+        if (!sdarray_reserve(arr, 3 * new_length / 2 + ((new_length % 2) != 0)))
+        {
+            return false;
+        }
+    }
+
+    uint8_t * const data = (uint8_t *) arr->data;
+    size_t const gap = index * arr->element_size;
+    size_t const size = sizeof(uint8_t) * arr->element_size * count;
+    memmove(data + gap + size, data + gap, sizeof(uint8_t) * arr->element_size * (arr->length - index));
+    if (count && aliased)
+    {
+        /* the source bytes before the gap stayed, the rest moved past it */
+        size_t const before = offset >= gap ? 0 : (gap - offset < size ? gap - offset : size);
+        memcpy(data + gap, data + offset, before);
+        memcpy(data + gap + before, data + offset + before + size, size - before);
+    }
+    else if (count && src)
+    {
+        memcpy(data + gap, src, size);
+    }
+    arr->length = new_length;
+
+    return true;
+}
+
+bool sdarray_erase_range(sdarray * const arr, size_t const index, size_t const count)
+{
+    if (index > arr->length || count > arr->length - index)
+    {
+        return false;
+    }
+
+    uint8_t * const at = ((uint8_t *) arr->data) + index * arr->element_size;
+    memmove(at, at + count * arr->element_size, sizeof(uint8_t) * arr->element_size * (arr->length - index - count));
+    arr->length -= count;
+
+    sdarray__shrink(arr);
+
+    return true;
+}
+
+bool sdarray_swap_remove(sdarray * const arr, size_t const index)
+{
+    if (index >= arr->length)
+    {
+        return false;
+    }
+
+    arr->length--;
+    if (index != arr->length)
+    {
+        memcpy(((uint8_t *) arr->data) + index * arr->element_size,
+               ((uint8_t *) arr->data) + arr->length * arr->element_size,
+               arr->element_size);
+    }
+
+    sdarray__shrink(arr);
+
+    return true;
+}
+
+size_t sdarray_remove_if(sdarray * const arr, bool (*pred)(void *element, void *ctx), void * const ctx)
+{
+    uint8_t * const data = (uint8_t *) arr->data;
+    size_t kept = 0;
+
+    for (size_t i = 0; i < arr->length; i++)
+    {
+        uint8_t * const element = data + i * arr->element_size;
+        if (pred(element, ctx))
+        {
+            continue;
+        }
+
+        if (kept != i)
+        {
+            memcpy(data + kept * arr->element_size, element, arr->element_size);
+        }
+        kept++;
+    }
+
+    size_t const removed = arr->length - kept;
+    arr->length = kept;
+
+    sdarray__shrink(arr);
+
+    return removed;
+}
+
+static void sdarray__radix_sort_u32(uint32_t * const data, uint32_t * const tmp, size_t const length)
+{
+    size_t counts[4][256] = {{0}};
+    for (size_t i = 0; i < length; i++)
+    {
+        for (int d = 0; d < 4; d++)
+        {
+            counts[d][(data[i] >> (8 * d)) & 0xff]++;
+        }
+    }
+
+    uint32_t *src = data;
+    uint32_t *dst = tmp;
+    for (int d = 0; d < 4; d++)
+    {
+        /* skip the pass if all keys share the digit */
+        if (counts[d][(src[0] >> (8 * d)) & 0xff] == length)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            size_t const count = counts[d][b];
+            counts[d][b] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            dst[counts[d][(src[i] >> (8 * d)) & 0xff]++] = src[i];
+        }
+
+        uint32_t * const swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != data)
+    {
+        memcpy(data, src, sizeof(uint32_t) * length);
+    }
+}
+
+static void sdarray__radix_sort_u64(uint64_t * const data, uint64_t * const tmp, size_t const length)
+{
+    size_t counts[8][256] = {{0}};
+    for (size_t i = 0; i < length; i++)
+    {
+        for (int d = 0; d < 8; d++)
+        {
+            counts[d][(data[i] >> (8 * d)) & 0xff]++;
+        }
+    }
+
+    uint64_t *src = data;
+    uint64_t *dst = tmp;
+    for (int d = 0; d < 8; d++)
+    {
+        /* skip the pass if all keys share the digit */
+        if (counts[d][(src[0] >> (8 * d)) & 0xff] == length)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            size_t const count = counts[d][b];
+            counts[d][b] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            dst[counts[d][(src[i] >> (8 * d)) & 0xff]++] = src[i];
+        }
+
+        uint64_t * const swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != data)
+    {
+        memcpy(data, src, sizeof(uint64_t) * length);
+    }
+}
+
+/* maps the keys to unsigned integers with the same ordering and back */
+static void sdarray__radix_map_u32(uint32_t * const data, size_t const length, sdarray_radix_key const key, bool const inverse)
+{
+    uint32_t const sign = (uint32_t) 1 << 31;
+    for (size_t i = 0; i < length; i++)
+    {
+        uint32_t const x = data[i];
+        if (key == SDARRAY_RADIX_I32)
+        {
+            data[i] = x ^ sign;
+        }
+        else if (!inverse)
+        {
+            data[i] = (x & sign) ? ~x : x | sign;
+        }
+        else
+        {
+            data[i] = (x & sign) ? x ^ sign : ~x;
+        }
+    }
+}
+
+static void sdarray__radix_map_u64(uint64_t * const data, size_t const length, sdarray_radix_key const key, bool const inverse)
+{
+    uint64_t const sign = (uint64_t) 1 << 63;
+    for (size_t i = 0; i < length; i++)
+    {
+        uint64_t const x = data[i];
+        if (key == SDARRAY_RADIX_I64)
+        {
+            data[i] = x ^ sign;
+        }
+        else if (!inverse)
+        {
+            data[i] = (x & sign) ? ~x : x | sign;
+        }
+        else
+        {
+            data[i] = (x & sign) ? x ^ sign : ~x;
+        }
+    }
+}
+
+bool sdarray_radix_sort(sdarray * const arr, sdarray_radix_key const key)
+{
+    bool const wide = key == SDARRAY_RADIX_U64 || key == SDARRAY_RADIX_I64 || key == SDARRAY_RADIX_F64;
+    if (arr->element_size != (wide ? sizeof(uint64_t) : sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    if (arr->length < 2)
+    {
+        return true;
+    }
+
+    void *tmp = SDARRAY_REALLOC(NULL, arr->element_size * arr->length);
+    if (tmp == NULL)
+    {
+        return false;
+    }
+
+    bool const mapped = key != SDARRAY_RADIX_U32 && key != SDARRAY_RADIX_U64;
+    if (wide)
+    {
+        if (mapped)
+        {
+            sdarray__radix_map_u64((uint64_t *) arr->data, arr->length, key, false);
+        }
+        sdarray__radix_sort_u64((uint64_t *) arr->data, (uint64_t *) tmp, arr->length);
+        if (mapped)
+        {
+            sdarray__radix_map_u64((uint64_t *) arr->data, arr->length, key, true);
+        }
+    }
+    else
+    {
+        if (mapped)
+        {
+            sdarray__radix_map_u32((uint32_t *) arr->data, arr->length, key, false);
+        }
+        sdarray__radix_sort_u32((uint32_t *) arr->data, (uint32_t *) tmp, arr->length);
+        if (mapped)
+        {
+            sdarray__radix_map_u32((uint32_t *) arr->data, arr->length, key, true);
+        }
+    }
+
+    SDARRAY_FREE(tmp);
+
     return true;
 }
 
+size_t sdarray_lower_bound(sdarray * const arr, const void * const key, int (*cmp)(const void *key, const void *element))
+{
+    size_t low = 0;
+    size_t high = arr->length;
+
+    while (low < high)
+    {
+        size_t const mid = low + (high - low) / 2;
+        if (cmp(key, ((uint8_t *) arr->data) + mid * arr->element_size) > 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+size_t sdarray_unique(sdarray * const arr, int (*cmp)(const void *a, const void *b))
+{
+    if (arr->length < 2)
+    {
+        return 0;
+    }
+
+    uint8_t * const data = (uint8_t *) arr->data;
+    size_t kept = 1;
+
+    for (size_t i = 1; i < arr->length; i++)
+    {
+        uint8_t * const element = data + i * arr->element_size;
+        if (cmp(data + (kept - 1) * arr->element_size, element) == 0)
+        {
+            continue;
+        }
+
+        if (kept != i)
+        {
+            memcpy(data + kept * arr->element_size, element, arr->element_size);
+        }
+        kept++;
+    }
+
+    size_t const removed = arr->length - kept;
+    arr->length = kept;
+
+    sdarray__shrink(arr);
+
+    return removed;
+}
+
+#ifdef SDARRAY_THREADS
+typedef struct
+{
+    uint8_t *src;
+    uint8_t *dst;
+    size_t low;
+    size_t mid;
+    size_t high;
+    /* part of [low, high) in the merged output written by this task */
+    size_t out_low;
+    size_t out_high;
+    size_t element_size;
+    int (*cmp)(const void *a, const void *b);
+} sdarray__sort_task;
+
+static void *sdarray__sort_chunk(void *arg)
+{
+    sdarray__sort_task * const task = (sdarray__sort_task *) arg;
+    qsort(task->src + task->low * task->element_size, task->high - task->low, task->element_size, task->cmp);
+    return NULL;
+}
+
+/* number of elements of the left run among the first `k` merged elements */
+static size_t sdarray__merge_split(sdarray__sort_task const * const task, size_t const k)
+{
+    size_t const es = task->element_size;
+    uint8_t const * const left = task->src + task->low * es;
+    uint8_t const * const right = task->src + task->mid * es;
+    size_t const left_length = task->mid - task->low;
+    size_t const right_length = task->high - task->mid;
+    size_t lo = k > right_length ? k - right_length : 0;
+    size_t hi = k < left_length ? k : left_length;
+
+    while (lo < hi)
+    {
+        size_t const i = lo + (hi - lo) / 2;
+        size_t const j = k - i;
+        /* left[i] still goes before right[j - 1], ties go to the left run */
+        if (task->cmp(right + (j - 1) * es, left + i * es) >= 0)
+        {
+            lo = i + 1;
+        }
+        else
+        {
+            hi = i;
+        }
+    }
+
+    return lo;
+}
+
+static void *sdarray__merge_chunks(void *arg)
+{
+    sdarray__sort_task * const task = (sdarray__sort_task *) arg;
+    size_t const es = task->element_size;
+    size_t const begin = task->out_low - task->low;
+    size_t const end = task->out_high - task->low;
+    size_t const left_begin = sdarray__merge_split(task, begin);
+    size_t const left_end = sdarray__merge_split(task, end);
+    uint8_t *out = task->dst + task->out_low * es;
+    size_t i = task->low + left_begin;
+    size_t j = task->mid + (begin - left_begin);
+    size_t const i_end = task->low + left_end;
+    size_t const j_end = task->mid + (end - left_end);
+
+    while (i < i_end && j < j_end)
+    {
+        /* take from the left run on ties to keep the merge stable */
+        if (task->cmp(task->src + j * es, task->src + i * es) < 0)
+        {
+            memcpy(out, task->src + j++ * es, es);
+        }
+        else
+        {
+            memcpy(out, task->src + i++ * es, es);
+        }
+        out += es;
+    }
+
+    memcpy(out, task->src + i * es, (i_end - i) * es);
+    out += (i_end - i) * es;
+    memcpy(out, task->src + j * es, (j_end - j) * es);
+
+    return NULL;
+}
+
+static void sdarray__run_tasks(sdarray__sort_task * const tasks, pthread_t * const threads, bool * const started, size_t const count, void *(*func)(void *))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        started[i] = pthread_create(&threads[i], NULL, func, &tasks[i]) == 0;
+        /* run the task on the current thread if no thread can be created */
+        if (!started[i])
+        {
+            func(&tasks[i]);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+bool sdarray_parallel_sort(sdarray * const arr, int (*cmp)(const void *a, const void *b), size_t const thread_count)
+{
+    if (arr->length < 2)
+    {
+        return true;
+    }
+
+    if (arr->length < SDARRAY_PARALLEL_SORT_THRESHOLD || thread_count < 2)
+    {
+        qsort(arr->data, arr->length, arr->element_size, cmp);
+        return true;
+    }
+
+    size_t const chunks = thread_count;
+    uint8_t *tmp = (uint8_t *) SDARRAY_REALLOC(NULL, arr->element_size * arr->length);
+    size_t *bounds = (size_t *) SDARRAY_REALLOC(NULL, sizeof(size_t) * (chunks + 1));
+    sdarray__sort_task *tasks = (sdarray__sort_task *) SDARRAY_REALLOC(NULL, sizeof(sdarray__sort_task) * chunks);
+    pthread_t *threads = (pthread_t *) SDARRAY_REALLOC(NULL, sizeof(pthread_t) * chunks);
+    bool *started = (bool *) SDARRAY_REALLOC(NULL, sizeof(bool) * chunks);
+    if (tmp == NULL || bounds == NULL || tasks == NULL || threads == NULL || started == NULL)
+    {
+        SDARRAY_FREE(tmp);
+        SDARRAY_FREE(bounds);
+        SDARRAY_FREE(tasks);
+        SDARRAY_FREE(threads);
+        SDARRAY_FREE(started);
+        return false;
+    }
+
+    for (size_t i = 0; i <= chunks; i++)
+    {
+        bounds[i] = arr->length / chunks * i + arr->length % chunks * i / chunks;
+    }
+
+    uint8_t *src = (uint8_t *) arr->data;
+    uint8_t *dst = tmp;
+
+    for (size_t i = 0; i < chunks; i++)
+    {
+        sdarray__sort_task const task = {src, dst, bounds[i], bounds[i + 1], bounds[i + 1], bounds[i], bounds[i + 1], arr->element_size, cmp};
+        tasks[i] = task;
+    }
+    sdarray__run_tasks(tasks, threads, started, chunks, sdarray__sort_chunk);
+
+    /* merge neighbouring runs until a single run is left */
+    for (size_t width = 1; width < chunks; width *= 2)
+    {
+        size_t const merges = (chunks + 2 * width - 1) / (2 * width);
+        /* split every merge so that all threads have work */
+        size_t const parts = chunks / merges;
+        size_t count = 0;
+        for (size_t i = 0; i < chunks; i += 2 * width)
+        {
+            size_t const mid = i + width < chunks ? i + width : chunks;
+            size_t const high = i + 2 * width < chunks ? i + 2 * width : chunks;
+            size_t const length = bounds[high] - bounds[i];
+            for (size_t part = 0; part < parts; part++)
+            {
+                sdarray__sort_task const task = {
+                    src, dst, bounds[i], bounds[mid], bounds[high],
+                    bounds[i] + length / parts * part + length % parts * part / parts,
+                    bounds[i] + length / parts * (part + 1) + length % parts * (part + 1) / parts,
+                    arr->element_size, cmp
+                };
+                tasks[count++] = task;
+            }
+        }
+        sdarray__run_tasks(tasks, threads, started, count, sdarray__merge_chunks);
+
+        uint8_t * const swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != arr->data)
+    {
+        memcpy(arr->data, src, arr->element_size * arr->length);
+    }
+
+    SDARRAY_FREE(tmp);
+    SDARRAY_FREE(bounds);
+    SDARRAY_FREE(tasks);
+    SDARRAY_FREE(threads);
+    SDARRAY_FREE(started);
+
+    return true;
+}
+#endif
+
 void *sdarray_at(sdarray * const arr, size_t const index)
 {
     return (void *) (((uint8_t *) arr->data) + index * arr->element_size);
@@ -0,0 +1,359 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     The storage is allocated by sdarray, see SDARRAY_REALLOC and
+ *     SDARRAY_FREE in sdarray.h.
+ *
+ * Growable double-ended queue implemented as a ring buffer with power-of-two
+ * capacity on top of `sdarray` storage. Pushing and popping at both ends is
+ * O(1) amortized.
+ */
+
+#ifndef INCLUDE_SDEQUE_H
+#define INCLUDE_SDEQUE_H
+
+#include "sdarray.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct
+{
+    /* only .data, .capacity and .element_size of the storage are used */
+    sdarray buf;
+    size_t head;
+    size_t length;
+} sdeque;
+
+/**
+ * Creates a new deque. The capacity is rounded up to a power of two.
+ *
+ * @param element_size Size of one element in bytes.
+ * @param init_capacity Initial capacity in elements.
+ * @return New deque, check `.buf.capacity` if `init_capacity` was > 0.
+ */
+sdeque sdeque_new(size_t const element_size, size_t const init_capacity);
+
+/**
+ * Frees the deque storage. Can be called repeatedly.
+ *
+ * @param dq Deque to free.
+ */
+void sdeque_free(sdeque * const dq);
+
+/**
+ * Makes sure the deque can hold at least `capacity` elements.
+ *
+ * @param dq Deque to reserve in.
+ * @param capacity Requested capacity, rounded up to a power of two.
+ * @return `true` upon success, `false` otherwise.
+ */
+bool sdeque_reserve(sdeque * const dq, size_t const capacity);
+
+bool sdeque_push_back(sdeque * const dq, const void * const element);
+bool sdeque_push_front(sdeque * const dq, const void * const element);
+bool sdeque_pop_back(sdeque * const dq, void * const element);
+bool sdeque_pop_front(sdeque * const dq, void * const element);
+
+/**
+ * Returns a pointer to the element at `index` counted from the front. The
+ * index is not checked.
+ *
+ * @param dq Deque.
+ * @param index Element index.
+ * @return Pointer to the element.
+ */
+void *sdeque_at(sdeque * const dq, size_t const index);
+
+/**
+ * Appends `count` elements at the back with at most two `memcpy` calls.
+ *
+ * @param dq Deque to append to.
+ * @param src Appended elements.
+ * @param count Number of elements.
+ * @return `true` upon success, `false` otherwise.
+ */
+bool sdeque_push_back_n(sdeque * const dq, const void * const src, size_t const count);
+
+/**
+ * Removes up to `count` elements from the front with at most two `memcpy`
+ * calls.
+ *
+ * @param dq Deque to remove from.
+ * @param dst Buffer for the removed elements or `NULL` to drop them, e.g.
+ * after they were written out through `sdeque_spans`.
+ * @param count Maximum number of elements to remove.
+ * @return Number of removed elements.
+ */
+size_t sdeque_pop_front_n(sdeque * const dq, void * const dst, size_t const count);
+
+/**
+ * Returns the elements as up to two contiguous spans in front-to-back order,
+ * suitable for `writev` or `memcpy` without copying the elements first. The
+ * second span is empty unless the elements wrap around the buffer end.
+ *
+ * @param dq Deque.
+ * @param first First span.
+ * @param first_length Number of elements in the first span.
+ * @param second Second span.
+ * @param second_length Number of elements in the second span.
+ */
+void sdeque_spans(sdeque * const dq, void ** const first, size_t * const first_length, void ** const second, size_t * const second_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*INCLUDE_SDEQUE_H*/
+
+#ifdef SDEQUE_IMPLEMENTATION
+
+static size_t sdeque__round_pow2(size_t const n)
+{
+    size_t capacity = 1;
+    while (capacity < n)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+static uint8_t *sdeque__slot(sdeque * const dq, size_t const index)
+{
+    return ((uint8_t *) dq->buf.data) + ((dq->head + index) & (dq->buf.capacity - 1)) * dq->buf.element_size;
+}
+
+static bool sdeque__grow(sdeque * const dq, size_t const count)
+{
+    if (dq->length + count <= dq->buf.capacity)
+    {
+        return true;
+    }
+    return sdeque_reserve(dq, 2 * (dq->length + count));
+}
+
+sdeque sdeque_new(size_t const element_size, size_t const init_capacity)
+{
+    sdeque dq = {.buf = sdarray_new(element_size, 0), .head = 0, .length = 0};
+    if (init_capacity > 0)
+    {
+        sdeque_reserve(&dq, init_capacity);
+    }
+    return dq;
+}
+
+void sdeque_free(sdeque * const dq)
+{
+    SDARRAY_FREE(dq->buf.data);
+    dq->buf.data = NULL;
+    dq->buf.capacity = 0;
+    dq->head = 0;
+    dq->length = 0;
+}
+
+bool sdeque_reserve(sdeque * const dq, size_t const capacity)
+{
+    size_t const old_capacity = dq->buf.capacity;
+    size_t const new_capacity = sdeque__round_pow2(capacity);
+    if (new_capacity <= old_capacity)
+    {
+        return true;
+    }
+
+    if (!sdarray_reserve(&dq->buf, new_capacity))
+    {
+        return false;
+    }
+
+    /* move the wrapped part right after the old end, the new capacity is at
+     * least twice the old one so it always fits */
+    if (dq->head + dq->length > old_capacity)
+    {
+        size_t const wrapped = dq->head + dq->length - old_capacity;
+        memcpy(((uint8_t *) dq->buf.data) + old_capacity * dq->buf.element_size,
+               dq->buf.data,
+               wrapped * dq->buf.element_size);
+    }
+
+    return true;
+}
+
+bool sdeque_push_back(sdeque * const dq, const void * const element)
+{
+    if (!sdeque__grow(dq, 1))
+    {
+        return false;
+    }
+
+    memcpy(sdeque__slot(dq, dq->length), element, dq->buf.element_size);
+    dq->length++;
+
+    return true;
+}
+
+bool sdeque_push_front(sdeque * const dq, const void * const element)
+{
+    if (!sdeque__grow(dq, 1))
+    {
+        return false;
+    }
+
+    dq->head = (dq->head - 1) & (dq->buf.capacity - 1);
+    memcpy(sdeque__slot(dq, 0), element, dq->buf.element_size);
+    dq->length++;
+
+    return true;
+}
+
+bool sdeque_pop_back(sdeque * const dq, void * const element)
+{
+    if (dq->length == 0)
+    {
+        return false;
+    }
+
+    dq->length--;
+    if (element != NULL)
+    {
+        memcpy(element, sdeque__slot(dq, dq->length), dq->buf.element_size);
+    }
+
+    return true;
+}
+
+bool sdeque_pop_front(sdeque * const dq, void * const element)
+{
+    if (dq->length == 0)
+    {
+        return false;
+    }
+
+    if (element != NULL)
+    {
+        memcpy(element, sdeque__slot(dq, 0), dq->buf.element_size);
+    }
+    dq->head = (dq->head + 1) & (dq->buf.capacity - 1);
+    dq->length--;
+
+    return true;
+}
+
+void *sdeque_at(sdeque * const dq, size_t const index)
+{
+    return (void *) sdeque__slot(dq, index);
+}
+
+bool sdeque_push_back_n(sdeque * const dq, const void * const src, size_t const count)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    if (!sdeque__grow(dq, count))
+    {
+        return false;
+    }
+
+    size_t const tail = (dq->head + dq->length) & (dq->buf.capacity - 1);
+    size_t const first = count < dq->buf.capacity - tail ? count : dq->buf.capacity - tail;
+    size_t const es = dq->buf.element_size;
+
+    memcpy(((uint8_t *) dq->buf.data) + tail * es, src, first * es);
+    memcpy(dq->buf.data, ((const uint8_t *) src) + first * es, (count - first) * es);
+    dq->length += count;
+
+    return true;
+}
+
+size_t sdeque_pop_front_n(sdeque * const dq, void * const dst, size_t const count)
+{
+    size_t const n = count < dq->length ? count : dq->length;
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    size_t const first = n < dq->buf.capacity - dq->head ? n : dq->buf.capacity - dq->head;
+    size_t const es = dq->buf.element_size;
+
+    if (dst != NULL)
+    {
+        memcpy(dst, ((uint8_t *) dq->buf.data) + dq->head * es, first * es);
+        memcpy(((uint8_t *) dst) + first * es, dq->buf.data, (n - first) * es);
+    }
+    dq->head = (dq->head + n) & (dq->buf.capacity - 1);
+    dq->length -= n;
+
+    return n;
+}
+
+void sdeque_spans(sdeque * const dq, void ** const first, size_t * const first_length, void ** const second, size_t * const second_length)
+{
+    size_t const to_end = dq->buf.capacity - dq->head;
+
+    *first = sdeque__slot(dq, 0);
+    *first_length = dq->length < to_end ? dq->length : to_end;
+    *second = dq->buf.data;
+    *second_length = dq->length - *first_length;
+}
+
+#endif /*SDEQUE_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
@@ -20,6 +20,9 @@
 #ifndef INCLUDE_SDLL_H
 #define INCLUDE_SDLL_H
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #if defined(SDLL_MALLOC) && !defined(SDLL_FREE) || !defined(SDLL_MALLOC) && defined(SDLL_FREE)
 #error "You must define both SDLL_MALLOC and SDLL_FREE, or neither."
 #endif
@@ -41,11 +44,26 @@ typedef struct sdll_node
     void *data;
 } sdll_node;
 
+/**
+ * Node pool carving `sdll_node`s out of large slabs. Released nodes are kept
+ * in an intrusive free list linked through their `.next` pointer and are
+ * only returned to the system by `sdll_pool_free`.
+ */
+typedef struct
+{
+    sdll_node *slabs;
+    sdll_node *free_list;
+    sdll_node *bump;
+    sdll_node *bump_end;
+    size_t nodes_per_slab;
+} sdll_pool;
+
 typedef struct
 {
     sdll_node *first;
     sdll_node *last;
     size_t length;
+    sdll_pool *pool;
 } sdll;
 
 sdll *sdll_new();
@@ -59,6 +77,105 @@ void sdll_unlink(sdll * const l, sdll_node * const node);
 void sdll_remove(sdll * const l, sdll_node **node, void (*free_func)(void *));
 void sdll_dummy_free(void * const data);
 
+/**
+ * Allocates a new list whose nodes come from `pool`. Several lists can share
+ * one pool. The pool must outlive the list.
+ *
+ * @param pool Node pool.
+ * @return New list or `NULL` on allocation failure.
+ */
+sdll *sdll_new_pooled(sdll_pool * const pool);
+
+/**
+ * Allocates a new node pool.
+ *
+ * @param nodes_per_slab Number of nodes allocated at once.
+ * @return New pool or `NULL` on allocation failure.
+ */
+sdll_pool *sdll_pool_new(size_t const nodes_per_slab);
+
+/**
+ * Frees all slabs of the pool at once, including nodes still linked in lists
+ * bound to the pool.
+ *
+ * @param pool Pool to free.
+ */
+void sdll_pool_free(sdll_pool **pool);
+
+/**
+ * Frees a node removed from the list by `sdll_unlink`, returning it to the
+ * list's pool if it has one.
+ *
+ * @param l List the node was unlinked from.
+ * @param node Unlinked node.
+ */
+void sdll_node_release(sdll * const l, sdll_node * const node);
+
+/**
+ * Moves the nodes `first` to `last` (inclusive) from `src` to `dst` after the
+ * node `after` in O(1). Both lists must use the same pool or no pool at all.
+ *
+ * @param dst Destination list.
+ * @param after Node of `dst` to insert after or `NULL` to insert at the front.
+ * @param src Source list, can be the same as `dst` if `after` is not in the
+ * moved range.
+ * @param first First moved node.
+ * @param last Last moved node.
+ * @param count Number of moved nodes, needed to update the lengths in O(1).
+ */
+void sdll_splice(sdll * const dst, sdll_node * const after, sdll * const src, sdll_node * const first, sdll_node * const last, size_t const count);
+
+/**
+ * Moves all nodes of `src` to the end of `dst` in O(1), leaving `src` empty.
+ * Both lists must use the same pool or no pool at all.
+ *
+ * @param dst Destination list.
+ * @param src Source list.
+ */
+void sdll_concat(sdll * const dst, sdll * const src);
+
+/**
+ * Appends `count` elements at once, linking them into the list only after all
+ * nodes were allocated.
+ *
+ * @param l List to append to.
+ * @param data Array of the appended data pointers.
+ * @param count Number of appended elements.
+ * @return `true` upon success, `false` on allocation failure in which case the
+ * list is unchanged.
+ */
+bool sdll_insert_last_array(sdll * const l, void * const * const data, size_t const count);
+
+/**
+ * Link for intrusive lists, embed it in your own struct and get the struct
+ * back with `SDLL_CONTAINER_OF`. Intrusive lists never allocate.
+ */
+typedef struct sdll_link
+{
+    struct sdll_link *next;
+    struct sdll_link *prev;
+} sdll_link;
+
+typedef struct
+{
+    sdll_link *first;
+    sdll_link *last;
+    size_t length;
+} sdll_ilist;
+
+/**
+ * Returns a pointer to the struct of `type` which contains the `sdll_link`
+ * pointed to by `ptr` as its `member`.
+ */
+#define SDLL_CONTAINER_OF(ptr, type, member) ((type *) (((char *) (ptr)) - offsetof(type, member)))
+
+void sdll_ilist_init(sdll_ilist * const l);
+void sdll_ilist_insert_after(sdll_ilist * const l, sdll_link * const node, sdll_link * const link);
+void sdll_ilist_insert_before(sdll_ilist * const l, sdll_link * const node, sdll_link * const link);
+void sdll_ilist_insert_first(sdll_ilist * const l, sdll_link * const link);
+void sdll_ilist_insert_last(sdll_ilist * const l, sdll_link * const link);
+void sdll_ilist_unlink(sdll_ilist * const l, sdll_link * const link);
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +184,50 @@ void sdll_dummy_free(void * const data);
 
 #ifdef SDLL_IMPLEMENTATION
 
+static sdll_node *sdll__node_alloc(sdll * const l)
+{
+    sdll_pool * const pool = l->pool;
+    if (pool == NULL)
+    {
+        return (sdll_node *) SDLL_MALLOC(sizeof(sdll_node));
+    }
+
+    if (pool->free_list != NULL)
+    {
+        sdll_node *node = pool->free_list;
+        pool->free_list = node->next;
+        return node;
+    }
+
+    if (pool->bump == pool->bump_end)
+    {
+        /* the first node of every slab links the slabs together */
+        sdll_node *slab = (sdll_node *) SDLL_MALLOC(sizeof(sdll_node) * (pool->nodes_per_slab + 1));
+        if (slab == NULL)
+        {
+            return NULL;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->bump = slab + 1;
+        pool->bump_end = slab + 1 + pool->nodes_per_slab;
+    }
+
+    return pool->bump++;
+}
+
+void sdll_node_release(sdll * const l, sdll_node * const node)
+{
+    if (l->pool == NULL)
+    {
+        SDLL_FREE(node);
+        return;
+    }
+
+    node->next = l->pool->free_list;
+    l->pool->free_list = node;
+}
+
 sdll *sdll_new()
 {
     sdll *l = (sdll *) SDLL_MALLOC(sizeof(sdll));
@@ -78,25 +239,88 @@ sdll *sdll_new()
     l->first = NULL;
     l->last = NULL;
     l->length = 0;
+    l->pool = NULL;
 
     return l;
 }
 
+sdll *sdll_new_pooled(sdll_pool * const pool)
+{
+    sdll *l = sdll_new();
+    if (l == NULL)
+    {
+        return NULL;
+    }
+
+    l->pool = pool;
+
+    return l;
+}
+
+sdll_pool *sdll_pool_new(size_t const nodes_per_slab)
+{
+    sdll_pool *pool = (sdll_pool *) SDLL_MALLOC(sizeof(sdll_pool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->nodes_per_slab = nodes_per_slab > 0 ? nodes_per_slab : 1;
+
+    return pool;
+}
+
+void sdll_pool_free(sdll_pool **pool)
+{
+    sdll_node *next = (*pool)->slabs;
+    while (next != NULL)
+    {
+        sdll_node *slab = next;
+        next = slab->next;
+        SDLL_FREE(slab);
+    }
+
+    SDLL_FREE(*pool);
+    *pool = NULL;
+}
+
 void sdll_empty(sdll * const l, void (*free_func)(void *))
 {
     if (l == NULL || l->first == NULL)
         return;
 
-    sdll_node *current;
-    sdll_node *next = l->first;
-
-    while (next != NULL)
+    if (l->pool != NULL)
+    {
+        if (free_func != sdll_dummy_free)
+        {
+            for (sdll_node *current = l->first; current != NULL; current = current->next)
+            {
+                free_func(current->data);
+            }
+        }
+
+        /* the nodes are already chained through .next, so the whole list
+         * becomes the head of the pool's free list in O(1) */
+        l->last->next = l->pool->free_list;
+        l->pool->free_list = l->first;
+    }
+    else
     {
-        current = next;
-        next = current->next;
+        sdll_node *current;
+        sdll_node *next = l->first;
+
+        while (next != NULL)
+        {
+            current = next;
+            next = current->next;
 
-        free_func(current->data);
-        SDLL_FREE(current);
+            free_func(current->data);
+            sdll_node_release(l, current);
+        }
     }
 
     l->first = NULL;
@@ -116,7 +340,10 @@ void sdll_insert_after(sdll * const l, sdll_node *node, void * const data)
     if (l == NULL)
         return;
 
-    sdll_node *new_node = (sdll_node *) SDLL_MALLOC(sizeof(sdll_node));
+    sdll_node *new_node = sdll__node_alloc(l);
+    if (new_node == NULL)
+        return;
+
     new_node->prev = node;
     new_node->data = data;
 
@@ -140,7 +367,10 @@ void sdll_insert_before(sdll * const l, sdll_node *node, void * const data)
     if (l == NULL)
         return;
 
-    sdll_node *new_node = (sdll_node *) SDLL_MALLOC(sizeof(sdll_node));
+    sdll_node *new_node = sdll__node_alloc(l);
+    if (new_node == NULL)
+        return;
+
     new_node->next = node;
     new_node->data = data;
 
@@ -166,7 +396,10 @@ void sdll_insert_first(sdll * const l, void * const data)
 
     if (l->first == NULL)
     {
-        sdll_node *new_node = (sdll_node *) SDLL_MALLOC(sizeof(sdll_node));
+        sdll_node *new_node = sdll__node_alloc(l);
+        if (new_node == NULL)
+            return;
+
         new_node->data = data;
 
         l->first = new_node;
@@ -225,7 +458,7 @@ void sdll_remove(sdll * const l, sdll_node **node, void (*free_func)(void *))
 {
     sdll_unlink(l, *node);
     free_func((*node)->data);
-    SDLL_FREE(*node);
+    sdll_node_release(l, *node);
     *node = NULL;
 }
 
@@ -234,6 +467,208 @@ void sdll_dummy_free(void * const data)
     (void) data;
 }
 
+void sdll_splice(sdll * const dst, sdll_node * const after, sdll * const src, sdll_node * const first, sdll_node * const last, size_t const count)
+{
+    /* detach the range from src */
+    if (first->prev == NULL)
+    {
+        src->first = last->next;
+    }
+    else
+    {
+        first->prev->next = last->next;
+    }
+
+    if (last->next == NULL)
+    {
+        src->last = first->prev;
+    }
+    else
+    {
+        last->next->prev = first->prev;
+    }
+    src->length -= count;
+
+    /* attach it to dst */
+    sdll_node * const next = after == NULL ? dst->first : after->next;
+    first->prev = after;
+    last->next = next;
+
+    if (after == NULL)
+    {
+        dst->first = first;
+    }
+    else
+    {
+        after->next = first;
+    }
+
+    if (next == NULL)
+    {
+        dst->last = last;
+    }
+    else
+    {
+        next->prev = last;
+    }
+    dst->length += count;
+}
+
+void sdll_concat(sdll * const dst, sdll * const src)
+{
+    if (src->first == NULL)
+        return;
+
+    sdll_splice(dst, dst->last, src, src->first, src->last, src->length);
+}
+
+bool sdll_insert_last_array(sdll * const l, void * const * const data, size_t const count)
+{
+    if (l == NULL || count == 0)
+        return l != NULL;
+
+    sdll_node *first = NULL;
+    sdll_node *last = NULL;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        sdll_node *new_node = sdll__node_alloc(l);
+        if (new_node == NULL)
+        {
+            while (first != NULL)
+            {
+                sdll_node *next = first->next;
+                sdll_node_release(l, first);
+                first = next;
+            }
+            return false;
+        }
+
+        new_node->data = data[i];
+        new_node->prev = last;
+        new_node->next = NULL;
+        if (last == NULL)
+        {
+            first = new_node;
+        }
+        else
+        {
+            last->next = new_node;
+        }
+        last = new_node;
+    }
+
+    first->prev = l->last;
+    if (l->last == NULL)
+    {
+        l->first = first;
+    }
+    else
+    {
+        l->last->next = first;
+    }
+    l->last = last;
+    l->length += count;
+
+    return true;
+}
+
+void sdll_ilist_init(sdll_ilist * const l)
+{
+    l->first = NULL;
+    l->last = NULL;
+    l->length = 0;
+}
+
+void sdll_ilist_insert_after(sdll_ilist * const l, sdll_link * const node, sdll_link * const link)
+{
+    link->prev = node;
+    link->next = node->next;
+
+    if (node->next == NULL)
+    {
+        l->last = link;
+    }
+    else
+    {
+        node->next->prev = link;
+    }
+
+    node->next = link;
+    l->length++;
+}
+
+void sdll_ilist_insert_before(sdll_ilist * const l, sdll_link * const node, sdll_link * const link)
+{
+    link->next = node;
+    link->prev = node->prev;
+
+    if (node->prev == NULL)
+    {
+        l->first = link;
+    }
+    else
+    {
+        node->prev->next = link;
+    }
+
+    node->prev = link;
+    l->length++;
+}
+
+void sdll_ilist_insert_first(sdll_ilist * const l, sdll_link * const link)
+{
+    if (l->first == NULL)
+    {
+        link->next = NULL;
+        link->prev = NULL;
+        l->first = link;
+        l->last = link;
+        l->length++;
+    }
+    else
+    {
+        sdll_ilist_insert_before(l, l->first, link);
+    }
+}
+
+void sdll_ilist_insert_last(sdll_ilist * const l, sdll_link * const link)
+{
+    if (l->last == NULL)
+    {
+        sdll_ilist_insert_first(l, link);
+    }
+    else
+    {
+        sdll_ilist_insert_after(l, l->last, link);
+    }
+}
+
+void sdll_ilist_unlink(sdll_ilist * const l, sdll_link * const link)
+{
+    if (link->prev == NULL)
+    {
+        l->first = link->next;
+    }
+    else
+    {
+        link->prev->next = link->next;
+    }
+
+    if (link->next == NULL)
+    {
+        l->last = link->prev;
+    }
+    else
+    {
+        link->next->prev = link->prev;
+    }
+
+    link->next = NULL;
+    link->prev = NULL;
+    l->length--;
+}
+
 #endif /*SDLL_IMPLEMENTATION*/
 
 /*
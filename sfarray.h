@@ -0,0 +1,386 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * File-backed persistent dynamic array (*NOTE*: requires POSIX mmap(),
+ * ftruncate() and msync(); with a strict `-std=c11` define `_GNU_SOURCE` or
+ * `_POSIX_C_SOURCE` before including any header).
+ *
+ * The elements live in a shared mapping of the file, after a small header
+ * holding the format version, element size and length. Opening an existing
+ * file only maps it, pages are read lazily on first access. The array grows
+ * by extending the file with ftruncate() and remapping it, so pointers to
+ * elements are invalidated by any operation that grows the array.
+ */
+
+#ifndef INCLUDE_SFARRAY_H
+#define INCLUDE_SFARRAY_H
+
+#include "sdarray.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SFARRAY_VERSION 1
+#define SFARRAY_HEADER_SIZE 64
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * On-disk header, the elements start at offset `SFARRAY_HEADER_SIZE`.
+ */
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t element_size;
+    uint64_t length;
+} sfarray_header;
+
+typedef struct
+{
+    int fd;
+    sfarray_header *header;
+    void *data;
+    size_t length;
+    size_t capacity;
+    size_t element_size;
+} sfarray;
+
+/**
+ * Opens or creates a file-backed array. An existing file must have been
+ * created with the same element size.
+ *
+ * @param fa Array to initialize.
+ * @param path Path to the backing file.
+ * @param element_size Size of one element in bytes.
+ * @return `true` upon success, `false` if the file cannot be opened, mapped
+ * or has an incompatible header.
+ */
+bool sfarray_open(sfarray * const fa, const char * const path, size_t const element_size);
+
+/**
+ * Flushes the mapping, truncates the file to the used length and closes it.
+ *
+ * @param fa Array to close.
+ * @return `true` upon success, `false` if flushing or truncating failed.
+ */
+bool sfarray_close(sfarray * const fa);
+
+/**
+ * Writes the modified pages back to the file using msync().
+ *
+ * @param fa Array to flush.
+ * @param wait Wait until the data is written (MS_SYNC) or only schedule the
+ * write (MS_ASYNC).
+ * @return `true` upon success, `false` otherwise.
+ */
+bool sfarray_flush(sfarray * const fa, bool const wait);
+
+/**
+ * Grows the backing file so the array can hold at least `capacity` elements.
+ *
+ * @param fa Array to reserve in.
+ * @param capacity Requested capacity in elements.
+ * @return `true` upon success, `false` otherwise.
+ */
+bool sfarray_reserve(sfarray * const fa, size_t const capacity);
+
+bool sfarray_add_from(sfarray * const fa, const void * const src, size_t const length);
+bool sfarray_push(sfarray * const fa, const void * const element);
+bool sfarray_pop(sfarray * const fa, void * const element);
+void *sfarray_at(sfarray * const fa, size_t const index);
+
+/**
+ * Wraps the mapped elements in an `sdarray`, e.g. for `sdarray_radix_sort` or
+ * `sdarray_lower_bound`. The view must not be passed to functions which
+ * reallocate or free the array and it's invalidated when `fa` grows.
+ *
+ * @param fa File-backed array.
+ * @return `sdarray` view of the elements.
+ */
+sdarray sfarray_view(sfarray * const fa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*INCLUDE_SFARRAY_H*/
+
+#ifdef SFARRAY_IMPLEMENTATION
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static char const sfarray__magic[8] = {'S', 'F', 'A', 'R', 'R', 'A', 'Y', '\0'};
+
+static bool sfarray__map(sfarray * const fa, size_t const capacity)
+{
+    size_t const size = SFARRAY_HEADER_SIZE + capacity * fa->element_size;
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fa->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+
+    fa->header = (sfarray_header *) map;
+    fa->data = ((uint8_t *) map) + SFARRAY_HEADER_SIZE;
+    fa->capacity = capacity;
+
+    return true;
+}
+
+static void sfarray__unmap(sfarray * const fa)
+{
+    munmap(fa->header, SFARRAY_HEADER_SIZE + fa->capacity * fa->element_size);
+    fa->header = NULL;
+    fa->data = NULL;
+}
+
+static bool sfarray__load(sfarray * const fa)
+{
+    struct stat st;
+    if (fstat(fa->fd, &st) != 0)
+    {
+        return false;
+    }
+
+    /* new file */
+    if (st.st_size == 0)
+    {
+        if (ftruncate(fa->fd, SFARRAY_HEADER_SIZE) != 0 || !sfarray__map(fa, 0))
+        {
+            return false;
+        }
+
+        memcpy(fa->header->magic, sfarray__magic, sizeof(sfarray__magic));
+        fa->header->version = SFARRAY_VERSION;
+        fa->header->header_size = SFARRAY_HEADER_SIZE;
+        fa->header->element_size = fa->element_size;
+        fa->header->length = 0;
+        return true;
+    }
+
+    if ((size_t) st.st_size < SFARRAY_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    size_t const capacity = ((size_t) st.st_size - SFARRAY_HEADER_SIZE) / fa->element_size;
+    if (!sfarray__map(fa, capacity))
+    {
+        return false;
+    }
+
+    if (memcmp(fa->header->magic, sfarray__magic, sizeof(sfarray__magic)) != 0
+        || fa->header->version != SFARRAY_VERSION
+        || fa->header->header_size != SFARRAY_HEADER_SIZE
+        || fa->header->element_size != fa->element_size
+        || fa->header->length > capacity)
+    {
+        sfarray__unmap(fa);
+        return false;
+    }
+    fa->length = fa->header->length;
+
+    return true;
+}
+
+bool sfarray_open(sfarray * const fa, const char * const path, size_t const element_size)
+{
+    fa->fd = -1;
+    fa->header = NULL;
+    fa->data = NULL;
+    fa->length = 0;
+    fa->capacity = 0;
+    fa->element_size = element_size;
+
+    if (element_size == 0 || (fa->fd = open(path, O_RDWR | O_CREAT, 0644)) < 0)
+    {
+        return false;
+    }
+
+    if (!sfarray__load(fa))
+    {
+        close(fa->fd);
+        fa->fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+bool sfarray_close(sfarray * const fa)
+{
+    if (fa->fd < 0)
+    {
+        return true;
+    }
+
+    bool ok = sfarray_flush(fa, true);
+    sfarray__unmap(fa);
+    ok = ftruncate(fa->fd, SFARRAY_HEADER_SIZE + fa->length * fa->element_size) == 0 && ok;
+    ok = close(fa->fd) == 0 && ok;
+
+    fa->fd = -1;
+    fa->length = 0;
+    fa->capacity = 0;
+
+    return ok;
+}
+
+bool sfarray_flush(sfarray * const fa, bool const wait)
+{
+    return msync(fa->header, SFARRAY_HEADER_SIZE + fa->capacity * fa->element_size, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+bool sfarray_reserve(sfarray * const fa, size_t const capacity)
+{
+    if (capacity <= fa->capacity)
+    {
+        return true;
+    }
+
+    if (ftruncate(fa->fd, SFARRAY_HEADER_SIZE + capacity * fa->element_size) != 0)
+    {
+        return false;
+    }
+
+    size_t const old_size = SFARRAY_HEADER_SIZE + fa->capacity * fa->element_size;
+    size_t const size = SFARRAY_HEADER_SIZE + capacity * fa->element_size;
+    void *map = MAP_FAILED;
+#ifdef MREMAP_MAYMOVE
+    /* grow in place, addresses of the elements stay valid */
+    map = mremap(fa->header, old_size, size, 0);
+#endif
+    if (map == MAP_FAILED)
+    {
+        /* the mapping is shared, so a new one sees the same data, the old one
+         * is only unmapped once the new one exists */
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fa->fd, 0);
+        if (map == MAP_FAILED)
+        {
+            /* the longer file is harmless, sfarray_close() truncates it */
+            return false;
+        }
+        munmap(fa->header, old_size);
+    }
+
+    fa->header = (sfarray_header *) map;
+    fa->data = ((uint8_t *) map) + SFARRAY_HEADER_SIZE;
+    fa->capacity = capacity;
+
+    return true;
+}
+
+bool sfarray_add_from(sfarray * const fa, const void * const src, size_t const length)
+{
+    size_t const new_length = fa->length + length;
+    if (new_length > fa->capacity)
+    {
+        /* ceil(new_length * 1.5) */
+        if (!sfarray_reserve(fa, 3 * new_length / 2 + ((new_length % 2) != 0)))
+        {
+            return false;
+        }
+    }
+
+    if (length && src)
+    {
+        memcpy(((uint8_t *) fa->data) + fa->length * fa->element_size, src, fa->element_size * length);
+    }
+    fa->length = new_length;
+    fa->header->length = new_length;
+
+    return true;
+}
+
+bool sfarray_push(sfarray * const fa, const void * const element)
+{
+    return sfarray_add_from(fa, element, 1);
+}
+
+bool sfarray_pop(sfarray * const fa, void * const element)
+{
+    if (fa->length == 0)
+    {
+        return false;
+    }
+
+    fa->length--;
+    fa->header->length = fa->length;
+    if (element != NULL)
+    {
+        memcpy(element, ((uint8_t *) fa->data) + fa->length * fa->element_size, fa->element_size);
+    }
+
+    return true;
+}
+
+void *sfarray_at(sfarray * const fa, size_t const index)
+{
+    return (void *) (((uint8_t *) fa->data) + index * fa->element_size);
+}
+
+sdarray sfarray_view(sfarray * const fa)
+{
+    return sdarray_wrap_ptr(fa->data, fa->element_size, fa->length);
+}
+
+#endif /*SFARRAY_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
@@ -15,6 +15,35 @@
  *         By default, shashtab uses stdlib calloc() and free() for memory
  *         management. You can substitute your own functions instead by defining
  *         these symbols. You must either define both, or neither.
+ *
+ *     #define SHASHTAB_REHASH_STEP 4
+ *
+ *         Number of buckets moved to the resized table by every shashtab_set
+ *         and shashtab_del while the table is being rehashed.
+ *
+ *     #define SHASHTAB_INLINE_KEY_SIZE 16
+ *
+ *         Keys up to this many bytes are also copied into the shashtab entry
+ *         and into the shashtab_oa slot, so a hit is confirmed by memcmp()
+ *         instead of following the key pointer into `key_func`.
+ *
+ * Keys are hashed by a 64-bit hash function in the style of wyhash, which
+ * reads 8 bytes at a time. Every table has its own `.hash_func` and `.seed`,
+ * both can be replaced while the table is empty. Set a random seed when the
+ * keys come from untrusted input, so they cannot be chosen to collide.
+ * Bucket counts are powers of two, so a bucket is selected by masking the hash.
+ *
+ * Two kinds of tables are available:
+ *
+ *     shashtab     separate chaining with a red-black tree in every bucket,
+ *                  it grows when there are more entries than buckets and
+ *                  shrinks when fewer than 1/8 of them are used, the entries
+ *                  are moved to the resized table incrementally, the trees
+ *                  are ordered by the stored hash first, so `key_func` is
+ *                  only called for keys with an equal hash
+ *     shashtab_oa  open addressing with Robin Hood hashing, the hashes, keys
+ *                  and values are stored in flat arrays without per-entry
+ *                  allocations, short keys are copied into the slots
  */
 
 #ifndef INCLUDE_SHASHTAB_H
@@ -22,6 +51,7 @@
 
 #include "sbintree.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #if defined(SHASHTAB_CALLOC) && !defined(SHASHTAB_FREE) || !defined(SHASHTAB_CALLOC) && defined(SHASHTAB_FREE)
@@ -33,17 +63,58 @@
 #define SHASHTAB_FREE(ptr) free(ptr)
 #endif
 
+#if !defined(SHASHTAB_REHASH_STEP)
+#define SHASHTAB_REHASH_STEP 4
+#endif
+
+#if !defined(SHASHTAB_INLINE_KEY_SIZE)
+#define SHASHTAB_INLINE_KEY_SIZE 16
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/**
+ * Hashes a key of `key_len` bytes, the default `.hash_func` of all tables.
+ *
+ * @param key Hashed key.
+ * @param key_len Length of the key in bytes.
+ * @param seed Seed which changes the hash of every key.
+ * @return 64-bit hash.
+ */
+uint64_t shashtab_hash(void const * const key, size_t const key_len, uint64_t const seed);
+
 typedef struct
 {
     sbintree **data;
     size_t capacity;
+    /* buckets being moved to `data` during a rehash, `NULL` otherwise */
+    sbintree **old_data;
+    size_t old_capacity;
+    /* buckets of `old_data` before this index are already moved */
+    size_t rehash_pos;
+    size_t length;
+    /* the table never shrinks below its initial capacity */
+    size_t min_capacity;
+    uint64_t (*hash_func)(void const *key, size_t key_len, uint64_t seed);
+    uint64_t seed;
 } shashtab;
 
+/**
+ * Entry of a shashtab, allocated with SBINTREE_MALLOC. The tree node comes
+ * first, so `free_func` receives the start of the entry.
+ */
+typedef struct
+{
+    sbintree node;
+    uint64_t hash;
+    size_t key_len;
+    /* copy of keys with key_len <= SHASHTAB_INLINE_KEY_SIZE */
+    uint8_t inline_key[SHASHTAB_INLINE_KEY_SIZE];
+} shashtab_entry;
+
 /**
  * Allocates a new hash table. You MUST check if the returned struct's .capacity
  * field is > 0.
@@ -53,24 +124,124 @@ typedef struct
  */
 shashtab shashtab_new(size_t const capacity);
 
-bool shashtab_set(shashtab const ht,
+/**
+ * Inserts a key, an existing key keeps its data. Like shashtab_del, it also
+ * moves a few buckets if the table is being rehashed, so `key_func` has to be
+ * the same for all calls on one table.
+ *
+ * @return `true` upon success, `false` if the entry cannot be allocated.
+ */
+bool shashtab_set(shashtab * const ht,
                   void * const key,
                   size_t const key_len,
                   int (*key_func)(void *key, void *node_key),
                   void * const data);
 
-void *shashtab_get(shashtab const ht,
+/**
+ * Looks up a key in both the old and the new buckets during a rehash without
+ * modifying the table, so lookups may run concurrently with each other.
+ *
+ * @return Data of the key, `NULL` if it's not in the table.
+ */
+void *shashtab_get(shashtab const * const ht,
                    void * const key,
                    size_t const key_len,
                    int (*key_func)(void *key, void *node_key));
 
-void shashtab_del(shashtab const ht,
+/**
+ * Same as shashtab_get for callers which already hold the hash of the key.
+ *
+ * @param hash Must be `ht->hash_func(key, key_len, ht->seed)`.
+ */
+void *shashtab_get_prehashed(shashtab const * const ht,
+                             uint64_t const hash,
+                             void * const key,
+                             size_t const key_len,
+                             int (*key_func)(void *key, void *node_key));
+
+/**
+ * Removes a key and releases its entry with `free_func`.
+ *
+ * @return `true` if the key was found and removed.
+ */
+bool shashtab_del(shashtab * const ht,
                   void * const key,
                   size_t const key_len,
                   int (*key_func)(void *key, void *node_key),
                   void (*free_func)(sbintree *));
 
-void shashtab_free(shashtab ht, void (*free_func)(sbintree *));
+void shashtab_free(shashtab * const ht, void (*free_func)(sbintree *));
+
+/**
+ * Open-addressing table. Entries are kept in parallel arrays indexed by slot,
+ * a zero hash marks an empty slot. Every entry is stored at most a few slots
+ * past its home slot, the Robin Hood insertion moves entries which are closer
+ * to their home slot out of the way.
+ */
+typedef struct
+{
+    uint32_t *hashes;
+    void **keys;
+    size_t *key_lens;
+    void **values;
+    /* copy of keys with key_len <= SHASHTAB_INLINE_KEY_SIZE */
+    uint8_t (*inline_keys)[SHASHTAB_INLINE_KEY_SIZE];
+    /* power of two */
+    size_t capacity;
+    size_t length;
+    uint64_t (*hash_func)(void const *key, size_t key_len, uint64_t seed);
+    uint64_t seed;
+} shashtab_oa;
+
+/**
+ * Allocates a new open-addressing hash table. You MUST check if the returned
+ * struct's .capacity field is > 0.
+ *
+ * @param capacity Number of entries the table holds without growing.
+ * @return Hash table struct.
+ */
+shashtab_oa shashtab_oa_new(size_t const capacity);
+
+/**
+ * Inserts a key, an existing key keeps its data like in shashtab_set. The
+ * table grows when it gets 7/8 full.
+ *
+ * @return `true` upon success, `false` if the table cannot grow.
+ */
+bool shashtab_oa_set(shashtab_oa * const ht,
+                     void * const key,
+                     size_t const key_len,
+                     int (*key_func)(void *key, void *node_key),
+                     void * const data);
+
+void *shashtab_oa_get(shashtab_oa const * const ht,
+                      void * const key,
+                      size_t const key_len,
+                      int (*key_func)(void *key, void *node_key));
+
+/**
+ * Same as shashtab_oa_get for callers which already hold the hash of the key.
+ *
+ * @param hash Must be `ht->hash_func(key, key_len, ht->seed)`.
+ */
+void *shashtab_oa_get_prehashed(shashtab_oa const * const ht,
+                                uint64_t const hash,
+                                void * const key,
+                                size_t const key_len,
+                                int (*key_func)(void *key, void *node_key));
+
+/**
+ * Removes a key by shifting the following entries back, no tombstones are
+ * left behind.
+ *
+ * @return `true` if the key was found and removed.
+ */
+bool shashtab_oa_del(shashtab_oa * const ht,
+                     void * const key,
+                     size_t const key_len,
+                     int (*key_func)(void *key, void *node_key));
+
+void shashtab_oa_free(shashtab_oa * const ht);
 
 #ifdef __cplusplus
 }
@@ -80,59 +251,128 @@ void shashtab_free(shashtab ht, void (*free_func)(sbintree *));
 
 #ifdef SHASHTAB_IMPLEMENTATION
 
-static unsigned int shashtab__fnv_1a_32(void * const buf, size_t const buf_len)
+/* 64x64 -> 128-bit multiplication, `a` receives the low and `b` the high half */
+static void shashtab__mum(uint64_t * const a, uint64_t * const b)
 {
-    unsigned char *bp = (unsigned char *) buf;
-    unsigned char * const be = bp + buf_len;
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t const ha = *a >> 32;
+    uint64_t const hb = *b >> 32;
+    uint64_t const la = (uint32_t) *a;
+    uint64_t const lb = (uint32_t) *b;
+    uint64_t const rh = ha * hb;
+    uint64_t const rm0 = ha * lb;
+    uint64_t const rm1 = hb * la;
+    uint64_t const rl = la * lb;
+    uint64_t const t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t const lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
 
-    unsigned int hash = 0x811c9dc5;
+static uint64_t shashtab__mix(uint64_t a, uint64_t b)
+{
+    shashtab__mum(&a, &b);
+    return a ^ b;
+}
 
-    while (bp < be)
-    {
-        hash ^= (unsigned int) *bp++;
-        hash += (hash << 1) + (hash << 4) + (hash << 7) + (hash << 8) + (hash << 24);
-    }
+static uint64_t shashtab__read64(uint8_t const * const p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
 
-    return hash;
+static uint64_t shashtab__read32(uint8_t const * const p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
 }
 
-static bool shashtab__is_prime(size_t const n)
+uint64_t shashtab_hash(void const * const key, size_t const key_len, uint64_t const seed)
 {
-    if (n <= 1)
-    {
-        return false;
-    }
-    if (n <= 3)
-    {
-        return true;
-    }
+    static uint64_t const secret[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+    };
 
-    if (n % 2 == 0 || n % 3 == 0)
+    uint8_t const *p = (uint8_t const *) key;
+    uint64_t state = seed ^ shashtab__mix(seed ^ secret[0], secret[1]);
+    uint64_t a;
+    uint64_t b;
+
+    if (key_len <= 16)
     {
-        return false;
+        if (key_len >= 4)
+        {
+            /* two possibly overlapping 4-byte reads from each end */
+            size_t const offset = (key_len >> 3) << 2;
+            a = (shashtab__read32(p) << 32) | shashtab__read32(p + offset);
+            b = (shashtab__read32(p + key_len - 4) << 32) | shashtab__read32(p + key_len - 4 - offset);
+        }
+        else if (key_len > 0)
+        {
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[key_len >> 1] << 8) | p[key_len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
     }
-
-    for (size_t i = 5; i * i <= n; i += 6)
+    else
     {
-        if (n % i == 0 || n % (i + 2) == 0)
+        size_t remaining = key_len;
+        if (remaining > 48)
         {
-            return false;
+            /* three independent lanes of 16 bytes */
+            uint64_t state1 = state;
+            uint64_t state2 = state;
+            do
+            {
+                state = shashtab__mix(shashtab__read64(p) ^ secret[1], shashtab__read64(p + 8) ^ state);
+                state1 = shashtab__mix(shashtab__read64(p + 16) ^ secret[2], shashtab__read64(p + 24) ^ state1);
+                state2 = shashtab__mix(shashtab__read64(p + 32) ^ secret[3], shashtab__read64(p + 40) ^ state2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            state ^= state1 ^ state2;
         }
+
+        while (remaining > 16)
+        {
+            state = shashtab__mix(shashtab__read64(p) ^ secret[1], shashtab__read64(p + 8) ^ state);
+            p += 16;
+            remaining -= 16;
+        }
+
+        /* the last 16 bytes, overlapping the previous block if needed */
+        a = shashtab__read64(p + remaining - 16);
+        b = shashtab__read64(p + remaining - 8);
     }
 
-    return true;
+    a ^= secret[1];
+    b ^= state;
+    shashtab__mum(&a, &b);
+    return shashtab__mix(a ^ secret[0] ^ key_len, b ^ secret[1]);
 }
 
-static size_t shashtab__next_prime(size_t const n)
+/* smallest power of two which is at least `n`, but at least 8 */
+static size_t shashtab__pow2_capacity(size_t const n)
 {
-    for (size_t i = n; i < 2 * n; i++)
+    size_t capacity = 8;
+    while (capacity < n)
     {
-        if (shashtab__is_prime(i))
-        {
-            return i;
-        }
+        capacity *= 2;
     }
-    return n;
+    return capacity;
 }
 
 static size_t shashtab__optimal_capacity(size_t const length)
@@ -143,9 +383,19 @@ static size_t shashtab__optimal_capacity(size_t const length)
 
 shashtab shashtab_new(size_t const capacity)
 {
-    shashtab ht = {.data = NULL, .capacity = 0};
-    /* about 70 % load factor */
-    size_t const init_capacity = shashtab__next_prime(shashtab__optimal_capacity(capacity));
+    shashtab ht = {
+        .data = NULL,
+        .capacity = 0,
+        .old_data = NULL,
+        .old_capacity = 0,
+        .rehash_pos = 0,
+        .length = 0,
+        .min_capacity = 0,
+        .hash_func = shashtab_hash,
+        .seed = 0,
+    };
+    /* at most about 70 % load factor */
+    size_t const init_capacity = shashtab__pow2_capacity(shashtab__optimal_capacity(capacity));
 
     if ((ht.data = (sbintree **) SHASHTAB_CALLOC(init_capacity, sizeof(sbintree *))) == NULL)
     {
@@ -153,27 +403,216 @@ shashtab shashtab_new(size_t const capacity)
     }
 
     ht.capacity = init_capacity;
+    ht.min_capacity = init_capacity;
     return ht;
 }
 
-bool shashtab_set(shashtab const ht,
+static void shashtab__keep_node(sbintree * const node)
+{
+    (void) node;
+}
+
+/* orders the entries of a bucket by their hash, then by their key */
+static int shashtab__compare(shashtab_entry const * const entry,
+                             uint64_t const hash,
+                             void * const key,
+                             size_t const key_len,
+                             int (*key_func)(void *key, void *node_key))
+{
+    if (hash != entry->hash)
+    {
+        return hash < entry->hash ? -1 : 1;
+    }
+    if (key_len == entry->key_len && key_len <= SHASHTAB_INLINE_KEY_SIZE && memcmp(key, entry->inline_key, key_len) == 0)
+    {
+        return 0;
+    }
+    return key_func(key, entry->node.key);
+}
+
+static sbintree *shashtab__find(sbintree * const root,
+                                uint64_t const hash,
+                                void * const key,
+                                size_t const key_len,
+                                int (*key_func)(void *key, void *node_key))
+{
+    sbintree *current = root;
+    while (current != NULL)
+    {
+        int cmp = shashtab__compare((shashtab_entry *) current, hash, key, key_len, key_func);
+        /* left subtree */
+        if (cmp < 0)
+        {
+            current = current->left;
+        }
+        /* right subtree */
+        else if (cmp > 0)
+        {
+            current = current->right;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return NULL;
+}
+
+/* child pointer of `parent` where the key belongs, it's not `NULL` if the key
+ * is already in the bucket */
+static sbintree **shashtab__find_link(sbintree ** const bucket,
+                                      uint64_t const hash,
+                                      void * const key,
+                                      size_t const key_len,
+                                      int (*key_func)(void *key, void *node_key),
+                                      sbintree ** const parent)
+{
+    sbintree **link = bucket;
+    *parent = NULL;
+    while (*link != NULL)
+    {
+        int cmp = shashtab__compare((shashtab_entry *) *link, hash, key, key_len, key_func);
+        /* left subtree */
+        if (cmp < 0)
+        {
+            *parent = *link;
+            link = &(*link)->left;
+        }
+        /* right subtree */
+        else if (cmp > 0)
+        {
+            *parent = *link;
+            link = &(*link)->right;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return link;
+}
+
+/* moves the next few buckets of an ongoing rehash to the new table */
+static void shashtab__rehash_step(shashtab * const ht, int (*key_func)(void *key, void *node_key))
+{
+    if (ht->old_data == NULL)
+    {
+        return;
+    }
+
+    for (size_t step = 0; step < SHASHTAB_REHASH_STEP && ht->rehash_pos < ht->old_capacity; step++)
+    {
+        sbintree **bucket = &ht->old_data[ht->rehash_pos++];
+        while (*bucket != NULL)
+        {
+            shashtab_entry *entry = (shashtab_entry *) *bucket;
+            sbintree_remove(bucket, &entry->node, shashtab__keep_node);
+
+            sbintree **new_bucket = &ht->data[entry->hash & (ht->capacity - 1)];
+            sbintree *parent;
+            sbintree **link = shashtab__find_link(new_bucket, entry->hash, entry->node.key, entry->key_len, key_func, &parent);
+            sbintree_link_node(new_bucket, parent, link, &entry->node);
+        }
+    }
+
+    if (ht->rehash_pos == ht->old_capacity)
+    {
+        SHASHTAB_FREE(ht->old_data);
+        ht->old_data = NULL;
+        ht->old_capacity = 0;
+        ht->rehash_pos = 0;
+    }
+}
+
+/* starts moving the entries to a table with `capacity` buckets */
+static void shashtab__resize(shashtab * const ht, size_t const capacity)
+{
+    if (ht->old_data != NULL || capacity == ht->capacity)
+    {
+        return;
+    }
+
+    sbintree **data = (sbintree **) SHASHTAB_CALLOC(capacity, sizeof(sbintree *));
+    if (data == NULL)
+    {
+        /* keep using the current buckets */
+        return;
+    }
+
+    ht->old_data = ht->data;
+    ht->old_capacity = ht->capacity;
+    ht->rehash_pos = 0;
+    ht->data = data;
+    ht->capacity = capacity;
+}
+
+/* bucket holding the entries with `hash`, either in the old or the new table */
+static sbintree **shashtab__bucket(shashtab const * const ht, uint64_t const hash)
+{
+    if (ht->old_data != NULL && (hash & (ht->old_capacity - 1)) >= ht->rehash_pos)
+    {
+        return &ht->old_data[hash & (ht->old_capacity - 1)];
+    }
+    return &ht->data[hash & (ht->capacity - 1)];
+}
+
+bool shashtab_set(shashtab * const ht,
                   void * const key,
                   size_t const key_len,
                   int (*key_func)(void *key, void *node_key),
                   void * const data)
 {
-    unsigned int const hash = shashtab__fnv_1a_32(key, key_len);
-    sbintree_insert(&ht.data[hash % ht.capacity], key, key_func, data);
+    shashtab__rehash_step(ht, key_func);
+
+    uint64_t const hash = ht->hash_func(key, key_len, ht->seed);
+    sbintree **bucket = shashtab__bucket(ht, hash);
+    sbintree *parent;
+    sbintree **link = shashtab__find_link(bucket, hash, key, key_len, key_func, &parent);
+    if (*link != NULL)
+    {
+        /* the key is already in the table */
+        return true;
+    }
+
+    shashtab_entry *entry = (shashtab_entry *) SBINTREE_MALLOC(sizeof(shashtab_entry));
+    if (entry == NULL)
+    {
+        return false;
+    }
+
+    entry->node.key = key;
+    entry->node.data = data;
+    entry->hash = hash;
+    entry->key_len = key_len;
+    if (key_len <= SHASHTAB_INLINE_KEY_SIZE)
+    {
+        memcpy(entry->inline_key, key, key_len);
+    }
+    sbintree_link_node(bucket, parent, link, &entry->node);
+
+    ht->length++;
+    if (ht->length > ht->capacity)
+    {
+        shashtab__resize(ht, 2 * ht->capacity);
+    }
     return true;
 }
 
-void *shashtab_get(shashtab const ht,
+void *shashtab_get(shashtab const * const ht,
                    void * const key,
                    size_t const key_len,
                    int (*key_func)(void *key, void *node_key))
 {
-    unsigned int const hash = shashtab__fnv_1a_32(key, key_len);
-    sbintree *node = sbintree_search(ht.data[hash % ht.capacity], key, key_func);
+    return shashtab_get_prehashed(ht, ht->hash_func(key, key_len, ht->seed), key, key_len, key_func);
+}
+
+void *shashtab_get_prehashed(shashtab const * const ht,
+                             uint64_t const hash,
+                             void * const key,
+                             size_t const key_len,
+                             int (*key_func)(void *key, void *node_key))
+{
+    sbintree *node = shashtab__find(*shashtab__bucket(ht, hash), hash, key, key_len, key_func);
     if (node == NULL)
     {
         return NULL;
@@ -181,33 +620,317 @@ void *shashtab_get(shashtab const ht,
     return node->data;
 }
 
-void shashtab_del(shashtab const ht,
+bool shashtab_del(shashtab * const ht,
                   void * const key,
                   size_t const key_len,
                   int (*key_func)(void *key, void *node_key),
                   void (*free_func)(sbintree *))
 {
-    unsigned int const hash = shashtab__fnv_1a_32(key, key_len);
-    sbintree *node = sbintree_search(ht.data[hash % ht.capacity], key, key_func);
+    shashtab__rehash_step(ht, key_func);
+
+    uint64_t const hash = ht->hash_func(key, key_len, ht->seed);
+    sbintree **bucket = shashtab__bucket(ht, hash);
+    sbintree *node = shashtab__find(*bucket, hash, key, key_len, key_func);
     if (node == NULL)
     {
-        return;
+        return false;
+    }
+    sbintree_remove(bucket, node, free_func);
+    ht->length--;
+
+    if (ht->length < ht->capacity / 8 && ht->capacity > ht->min_capacity)
+    {
+        size_t capacity = shashtab__pow2_capacity(shashtab__optimal_capacity(ht->length));
+        shashtab__resize(ht, capacity < ht->min_capacity ? ht->min_capacity : capacity);
     }
-    sbintree_remove(&ht.data[hash % ht.capacity], node, free_func);
+
+    return true;
 }
 
-void shashtab_free(shashtab ht, void (*free_func)(sbintree *))
+void shashtab_free(shashtab * const ht, void (*free_func)(sbintree *))
 {
-    for (size_t i = 0; i < ht.capacity; i++)
+    for (size_t i = 0; i < ht->capacity; i++)
     {
-        if (ht.data[i] != NULL)
+        if (ht->data[i] != NULL)
         {
-            sbintree_free(&ht.data[i], free_func);
+            sbintree_free(&ht->data[i], free_func);
         }
     }
 
-    SHASHTAB_FREE(ht.data);
-    ht.capacity = 0;
+    for (size_t i = ht->rehash_pos; i < ht->old_capacity; i++)
+    {
+        if (ht->old_data[i] != NULL)
+        {
+            sbintree_free(&ht->old_data[i], free_func);
+        }
+    }
+
+    SHASHTAB_FREE(ht->data);
+    SHASHTAB_FREE(ht->old_data);
+    ht->data = NULL;
+    ht->old_data = NULL;
+    ht->capacity = 0;
+    ht->old_capacity = 0;
+    ht->rehash_pos = 0;
+    ht->length = 0;
+}
+
+static uint32_t shashtab__oa_stored_hash(uint64_t const hash)
+{
+    /* the low half is enough to select a slot and to reject most other keys */
+    uint32_t const stored = (uint32_t) hash;
+    /* 0 marks an empty slot */
+    return stored == 0 ? 1 : stored;
+}
+
+static uint32_t shashtab__oa_hash(shashtab_oa const * const ht, void * const key, size_t const key_len)
+{
+    return shashtab__oa_stored_hash(ht->hash_func(key, key_len, ht->seed));
+}
+
+static bool shashtab__oa_alloc(shashtab_oa * const ht, size_t const capacity)
+{
+    /* one allocation, the pointer-sized arrays go first to keep them aligned */
+    size_t const slot_size = sizeof(void *) + sizeof(size_t) + sizeof(void *) + sizeof(uint32_t) +
+                             SHASHTAB_INLINE_KEY_SIZE;
+    uint8_t *block = (uint8_t *) SHASHTAB_CALLOC(capacity, slot_size);
+    if (block == NULL)
+    {
+        return false;
+    }
+
+    ht->keys = (void **) block;
+    ht->key_lens = (size_t *) (block + capacity * sizeof(void *));
+    ht->values = (void **) (block + capacity * (sizeof(void *) + sizeof(size_t)));
+    ht->hashes = (uint32_t *) (block + capacity * (2 * sizeof(void *) + sizeof(size_t)));
+    ht->inline_keys = (uint8_t (*)[SHASHTAB_INLINE_KEY_SIZE]) (block + capacity * (2 * sizeof(void *) +
+                                                                                  sizeof(size_t) + sizeof(uint32_t)));
+    ht->capacity = capacity;
+    ht->length = 0;
+
+    return true;
+}
+
+shashtab_oa shashtab_oa_new(size_t const capacity)
+{
+    shashtab_oa ht = {
+        .hashes = NULL,
+        .keys = NULL,
+        .key_lens = NULL,
+        .values = NULL,
+        .inline_keys = NULL,
+        .capacity = 0,
+        .length = 0,
+        .hash_func = shashtab_hash,
+        .seed = 0,
+    };
+
+    /* at most 7/8 of the slots are used */
+    size_t init_capacity = 8;
+    while (init_capacity / 8 * 7 < capacity)
+    {
+        init_capacity *= 2;
+    }
+
+    shashtab__oa_alloc(&ht, init_capacity);
+    return ht;
+}
+
+/* distance of the entry in `slot` from its home slot */
+static size_t shashtab__oa_distance(shashtab_oa const * const ht, size_t const slot)
+{
+    return (slot - (ht->hashes[slot] & (ht->capacity - 1))) & (ht->capacity - 1);
+}
+
+/* inserts an entry whose key is not in the table, there must be a free slot,
+ * `inline_key` holds the bytes of a short key */
+static void shashtab__oa_place(shashtab_oa * const ht,
+                               uint32_t hash,
+                               void *key,
+                               size_t key_len,
+                               void const * const inline_key,
+                               void *data)
+{
+    size_t const mask = ht->capacity - 1;
+    size_t slot = hash & mask;
+    size_t distance = 0;
+    uint8_t key_bytes[SHASHTAB_INLINE_KEY_SIZE] = {0};
+    if (key_len <= SHASHTAB_INLINE_KEY_SIZE)
+    {
+        memcpy(key_bytes, inline_key, key_len);
+    }
+
+    while (ht->hashes[slot] != 0)
+    {
+        size_t const existing_distance = shashtab__oa_distance(ht, slot);
+        if (existing_distance < distance)
+        {
+            /* take the slot from the richer entry and continue inserting it */
+            uint32_t const tmp_hash = ht->hashes[slot];
+            void * const tmp_key = ht->keys[slot];
+            size_t const tmp_key_len = ht->key_lens[slot];
+            void * const tmp_data = ht->values[slot];
+            uint8_t tmp_bytes[SHASHTAB_INLINE_KEY_SIZE];
+            memcpy(tmp_bytes, ht->inline_keys[slot], SHASHTAB_INLINE_KEY_SIZE);
+
+            ht->hashes[slot] = hash;
+            ht->keys[slot] = key;
+            ht->key_lens[slot] = key_len;
+            ht->values[slot] = data;
+            memcpy(ht->inline_keys[slot], key_bytes, SHASHTAB_INLINE_KEY_SIZE);
+
+            hash = tmp_hash;
+            key = tmp_key;
+            key_len = tmp_key_len;
+            data = tmp_data;
+            memcpy(key_bytes, tmp_bytes, SHASHTAB_INLINE_KEY_SIZE);
+            distance = existing_distance;
+        }
+
+        slot = (slot + 1) & mask;
+        distance++;
+    }
+
+    ht->hashes[slot] = hash;
+    ht->keys[slot] = key;
+    ht->key_lens[slot] = key_len;
+    ht->values[slot] = data;
+    memcpy(ht->inline_keys[slot], key_bytes, SHASHTAB_INLINE_KEY_SIZE);
+    ht->length++;
+}
+
+static size_t shashtab__oa_find(shashtab_oa const * const ht,
+                                uint32_t const hash,
+                                void * const key,
+                                size_t const key_len,
+                                int (*key_func)(void *key, void *node_key))
+{
+    size_t const mask = ht->capacity - 1;
+    size_t slot = hash & mask;
+
+    for (size_t distance = 0; ht->hashes[slot] != 0; distance++)
+    {
+        /* the key would have taken this slot if it was in the table */
+        if (shashtab__oa_distance(ht, slot) < distance)
+        {
+            break;
+        }
+
+        if (ht->hashes[slot] == hash && ht->key_lens[slot] == key_len &&
+            ((key_len <= SHASHTAB_INLINE_KEY_SIZE && memcmp(key, ht->inline_keys[slot], key_len) == 0) ||
+             key_func(key, ht->keys[slot]) == 0))
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return ht->capacity;
+}
+
+static bool shashtab__oa_grow(shashtab_oa * const ht)
+{
+    shashtab_oa old = *ht;
+    if (!shashtab__oa_alloc(ht, old.capacity * 2))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < old.capacity; i++)
+    {
+        if (old.hashes[i] != 0)
+        {
+            shashtab__oa_place(ht, old.hashes[i], old.keys[i], old.key_lens[i], old.inline_keys[i], old.values[i]);
+        }
+    }
+
+    SHASHTAB_FREE(old.keys);
+    return true;
+}
+
+bool shashtab_oa_set(shashtab_oa * const ht,
+                     void * const key,
+                     size_t const key_len,
+                     int (*key_func)(void *key, void *node_key),
+                     void * const data)
+{
+    uint32_t const hash = shashtab__oa_hash(ht, key, key_len);
+    size_t const slot = shashtab__oa_find(ht, hash, key, key_len, key_func);
+    if (slot != ht->capacity)
+    {
+        return true;
+    }
+
+    if (ht->length + 1 > ht->capacity / 8 * 7 && !shashtab__oa_grow(ht))
+    {
+        return false;
+    }
+
+    shashtab__oa_place(ht, hash, key, key_len, key, data);
+    return true;
+}
+
+void *shashtab_oa_get(shashtab_oa const * const ht,
+                      void * const key,
+                      size_t const key_len,
+                      int (*key_func)(void *key, void *node_key))
+{
+    return shashtab_oa_get_prehashed(ht, ht->hash_func(key, key_len, ht->seed), key, key_len, key_func);
+}
+
+void *shashtab_oa_get_prehashed(shashtab_oa const * const ht,
+                                uint64_t const hash,
+                                void * const key,
+                                size_t const key_len,
+                                int (*key_func)(void *key, void *node_key))
+{
+    size_t const slot = shashtab__oa_find(ht, shashtab__oa_stored_hash(hash), key, key_len, key_func);
+    if (slot == ht->capacity)
+    {
+        return NULL;
+    }
+    return ht->values[slot];
+}
+
+bool shashtab_oa_del(shashtab_oa * const ht,
+                     void * const key,
+                     size_t const key_len,
+                     int (*key_func)(void *key, void *node_key))
+{
+    size_t slot = shashtab__oa_find(ht, shashtab__oa_hash(ht, key, key_len), key, key_len, key_func);
+    if (slot == ht->capacity)
+    {
+        return false;
+    }
+
+    size_t const mask = ht->capacity - 1;
+    size_t next = (slot + 1) & mask;
+    while (ht->hashes[next] != 0 && shashtab__oa_distance(ht, next) > 0)
+    {
+        ht->hashes[slot] = ht->hashes[next];
+        ht->keys[slot] = ht->keys[next];
+        ht->key_lens[slot] = ht->key_lens[next];
+        ht->values[slot] = ht->values[next];
+        memcpy(ht->inline_keys[slot], ht->inline_keys[next], SHASHTAB_INLINE_KEY_SIZE);
+        slot = next;
+        next = (next + 1) & mask;
+    }
+
+    ht->hashes[slot] = 0;
+    ht->length--;
+    return true;
+}
+
+void shashtab_oa_free(shashtab_oa * const ht)
+{
+    SHASHTAB_FREE(ht->keys);
+    ht->hashes = NULL;
+    ht->keys = NULL;
+    ht->key_lens = NULL;
+    ht->values = NULL;
+    ht->inline_keys = NULL;
+    ht->capacity = 0;
+    ht->length = 0;
 }
 
 #endif /*SHASHTAB_IMPLEMENTATION*/
@@ -0,0 +1,373 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     #define SQUEUE_MALLOC(size) malloc(size)
+ *     #define SQUEUE_FREE(ptr)    free(ptr)
+ *
+ *         These defines only need to be set in the file containing
+ *         #define SQUEUE_IMPLEMENTATION.
+ *
+ *         By default, squeue uses stdlib malloc() and free() for memory
+ *         management. You can substitute your own functions instead by defining
+ *         these symbols. You must either define both, or neither.
+ *
+ *     #define SQUEUE_CACHE_LINE 64
+ *
+ *         Alignment used to keep the producer and consumer indices on separate
+ *         cache lines.
+ *
+ * Bounded lock-free queues using C11 atomics:
+ *
+ *     squeue_spsc  single-producer/single-consumer ring buffer, the producer
+ *                  and consumer cache each other's index and only reload it
+ *                  when the queue looks full or empty
+ *     squeue_mpmc  multi-producer/multi-consumer queue with a sequence number
+ *                  per cell (Dmitry Vyukov's bounded MPMC queue)
+ *
+ * Both capacities are rounded up to a power of two. The queue structs are
+ * over-aligned, so allocate them dynamically with aligned_alloc() instead of
+ * malloc(). The structs hold `_Atomic` members, so the header is C11 only and
+ * cannot be included from C++.
+ */
+
+#ifndef INCLUDE_SQUEUE_H
+#define INCLUDE_SQUEUE_H
+
+#ifdef __cplusplus
+#error "squeue.h requires C11 atomics (<stdatomic.h>, _Atomic, _Alignas) and cannot be compiled as C++."
+#endif
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(SQUEUE_MALLOC) && !defined(SQUEUE_FREE) || !defined(SQUEUE_MALLOC) && defined(SQUEUE_FREE)
+#error "You must define both SQUEUE_MALLOC and SQUEUE_FREE, or neither."
+#endif
+#if !defined(SQUEUE_MALLOC) && !defined(SQUEUE_FREE)
+#include <stdlib.h>
+#define SQUEUE_MALLOC(size) malloc(size)
+#define SQUEUE_FREE(ptr) free(ptr)
+#endif
+
+#if !defined(SQUEUE_CACHE_LINE)
+#define SQUEUE_CACHE_LINE 64
+#endif
+
+typedef struct
+{
+    /* consumer side */
+    _Alignas(SQUEUE_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail;
+    /* producer side */
+    _Alignas(SQUEUE_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head;
+    /* read-only after initialization */
+    _Alignas(SQUEUE_CACHE_LINE) uint8_t *buffer;
+    size_t mask;
+    size_t element_size;
+} squeue_spsc;
+
+typedef struct
+{
+    _Alignas(SQUEUE_CACHE_LINE) atomic_size_t enqueue_pos;
+    _Alignas(SQUEUE_CACHE_LINE) atomic_size_t dequeue_pos;
+    /* read-only after initialization */
+    _Alignas(SQUEUE_CACHE_LINE) uint8_t *cells;
+    size_t mask;
+    size_t element_size;
+    size_t cell_size;
+} squeue_mpmc;
+
+/**
+ * Initializes a single-producer/single-consumer queue.
+ *
+ * @param q Queue to initialize.
+ * @param element_size Size of one element in bytes.
+ * @param capacity Maximum number of queued elements, rounded up to a power of
+ * two.
+ * @return `true` upon success, `false` if the buffer cannot be allocated.
+ */
+bool squeue_spsc_init(squeue_spsc * const q, size_t const element_size, size_t const capacity);
+void squeue_spsc_destroy(squeue_spsc * const q);
+
+/**
+ * Copies the element into the queue. Must only be called by the producer.
+ *
+ * @return `false` if the queue is full, `true` otherwise.
+ */
+bool squeue_spsc_push(squeue_spsc * const q, const void * const element);
+
+/**
+ * Copies the oldest element out of the queue. Must only be called by the
+ * consumer.
+ *
+ * @return `false` if the queue is empty, `true` otherwise.
+ */
+bool squeue_spsc_pop(squeue_spsc * const q, void * const element);
+
+/**
+ * Initializes a multi-producer/multi-consumer queue.
+ *
+ * @param q Queue to initialize.
+ * @param element_size Size of one element in bytes.
+ * @param capacity Maximum number of queued elements, rounded up to a power of
+ * two (at least 2).
+ * @return `true` upon success, `false` if the buffer cannot be allocated.
+ */
+bool squeue_mpmc_init(squeue_mpmc * const q, size_t const element_size, size_t const capacity);
+void squeue_mpmc_destroy(squeue_mpmc * const q);
+
+/**
+ * Copies the element into the queue. Can be called from any thread.
+ *
+ * @return `false` if the queue is full, `true` otherwise.
+ */
+bool squeue_mpmc_push(squeue_mpmc * const q, const void * const element);
+
+/**
+ * Copies the oldest element out of the queue. Can be called from any thread.
+ *
+ * @return `false` if the queue is empty, `true` otherwise.
+ */
+bool squeue_mpmc_pop(squeue_mpmc * const q, void * const element);
+
+#endif /*INCLUDE_SQUEUE_H*/
+
+#ifdef SQUEUE_IMPLEMENTATION
+
+static size_t squeue__round_pow2(size_t const n)
+{
+    size_t capacity = 1;
+    while (capacity < n)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+bool squeue_spsc_init(squeue_spsc * const q, size_t const element_size, size_t const capacity)
+{
+    size_t const rounded = squeue__round_pow2(capacity);
+
+    if ((q->buffer = (uint8_t *) SQUEUE_MALLOC(element_size * rounded)) == NULL)
+    {
+        return false;
+    }
+
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->cached_tail = 0;
+    q->cached_head = 0;
+    q->mask = rounded - 1;
+    q->element_size = element_size;
+
+    return true;
+}
+
+void squeue_spsc_destroy(squeue_spsc * const q)
+{
+    SQUEUE_FREE(q->buffer);
+    q->buffer = NULL;
+}
+
+bool squeue_spsc_push(squeue_spsc * const q, const void * const element)
+{
+    size_t const tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (tail - q->cached_head > q->mask)
+    {
+        q->cached_head = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail - q->cached_head > q->mask)
+        {
+            return false;
+        }
+    }
+
+    memcpy(q->buffer + (tail & q->mask) * q->element_size, element, q->element_size);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+bool squeue_spsc_pop(squeue_spsc * const q, void * const element)
+{
+    size_t const head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    if (head == q->cached_tail)
+    {
+        q->cached_tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head == q->cached_tail)
+        {
+            return false;
+        }
+    }
+
+    memcpy(element, q->buffer + (head & q->mask) * q->element_size, q->element_size);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+static atomic_size_t *squeue__mpmc_sequence(squeue_mpmc * const q, size_t const pos)
+{
+    return (atomic_size_t *) (q->cells + (pos & q->mask) * q->cell_size);
+}
+
+bool squeue_mpmc_init(squeue_mpmc * const q, size_t const element_size, size_t const capacity)
+{
+    size_t const rounded = squeue__round_pow2(capacity < 2 ? 2 : capacity);
+    size_t const align = sizeof(atomic_size_t);
+
+    /* every cell holds its sequence number followed by the element */
+    q->cell_size = (sizeof(atomic_size_t) + element_size + align - 1) / align * align;
+    if ((q->cells = (uint8_t *) SQUEUE_MALLOC(q->cell_size * rounded)) == NULL)
+    {
+        return false;
+    }
+
+    q->mask = rounded - 1;
+    q->element_size = element_size;
+    for (size_t i = 0; i < rounded; i++)
+    {
+        atomic_init(squeue__mpmc_sequence(q, i), i);
+    }
+    atomic_init(&q->enqueue_pos, 0);
+    atomic_init(&q->dequeue_pos, 0);
+
+    return true;
+}
+
+void squeue_mpmc_destroy(squeue_mpmc * const q)
+{
+    SQUEUE_FREE(q->cells);
+    q->cells = NULL;
+}
+
+bool squeue_mpmc_push(squeue_mpmc * const q, const void * const element)
+{
+    size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+    atomic_size_t *sequence;
+
+    for (;;)
+    {
+        sequence = squeue__mpmc_sequence(q, pos);
+        size_t const seq = atomic_load_explicit(sequence, memory_order_acquire);
+        intptr_t const diff = (intptr_t) seq - (intptr_t) pos;
+
+        /* the cell is free, try to claim it */
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        /* the cell still holds an element from the previous lap */
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(((uint8_t *) sequence) + sizeof(atomic_size_t), element, q->element_size);
+    atomic_store_explicit(sequence, pos + 1, memory_order_release);
+
+    return true;
+}
+
+bool squeue_mpmc_pop(squeue_mpmc * const q, void * const element)
+{
+    size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+    atomic_size_t *sequence;
+
+    for (;;)
+    {
+        sequence = squeue__mpmc_sequence(q, pos);
+        size_t const seq = atomic_load_explicit(sequence, memory_order_acquire);
+        intptr_t const diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+        /* the cell holds an element, try to claim it */
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        /* the cell was not written yet */
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(element, ((uint8_t *) sequence) + sizeof(atomic_size_t), q->element_size);
+    atomic_store_explicit(sequence, pos + q->mask + 1, memory_order_release);
+
+    return true;
+}
+
+#endif /*SQUEUE_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
@@ -0,0 +1,340 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     #define SSEGARRAY_REALLOC(ptr,size) realloc(ptr,size)
+ *     #define SSEGARRAY_FREE(ptr)         free(ptr)
+ *
+ *         These defines only need to be set in the file containing
+ *         #define SSEGARRAY_IMPLEMENTATION.
+ *
+ *         By default, ssegarray uses stdlib realloc() and free() for memory
+ *         management. You can substitute your own functions instead by defining
+ *         these symbols. You must either define both, or neither.
+ *
+ * Segmented dynamic array. Elements are stored in fixed-size blocks of
+ * 2^block_shift elements which are never moved, so pointers to elements stay
+ * valid while the array grows and growing never copies existing elements. On
+ * POSIX systems the blocks can be allocated directly with mmap(). Anonymous
+ * mappings are not part of strict POSIX, so with e.g. `-std=c11` define
+ * `_DEFAULT_SOURCE` or `_GNU_SOURCE` before including any header, otherwise
+ * the blocks come from SSEGARRAY_REALLOC and a warning is emitted.
+ */
+
+#ifndef INCLUDE_SSEGARRAY_H
+#define INCLUDE_SSEGARRAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(SSEGARRAY_REALLOC) && !defined(SSEGARRAY_FREE) || !defined(SSEGARRAY_REALLOC) && defined(SSEGARRAY_FREE)
+#error "You must define both SSEGARRAY_REALLOC and SSEGARRAY_FREE, or neither."
+#endif
+#if !defined(SSEGARRAY_REALLOC) && !defined(SSEGARRAY_FREE)
+#include <stdlib.h>
+#define SSEGARRAY_REALLOC(ptr, size) realloc(ptr, size)
+#define SSEGARRAY_FREE(ptr) free(ptr)
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct
+{
+    void **blocks;
+    size_t block_count;
+    size_t blocks_capacity;
+    size_t length;
+    size_t element_size;
+    size_t block_shift;
+    bool use_mmap;
+} ssegarray;
+
+/**
+ * Creates a new empty segmented array. No memory is allocated until the first
+ * element is pushed.
+ *
+ * @param element_size Size of one element in bytes.
+ * @param block_shift Each block holds `1 << block_shift` elements.
+ * @param use_mmap Allocate the blocks with mmap(), ignored if anonymous mmap()
+ * mappings are unavailable, see the top of this file. The `.use_mmap` field of
+ * the returned array tells whether mmap() is used.
+ * @return New segmented array.
+ */
+ssegarray ssegarray_new(size_t const element_size, size_t const block_shift, bool const use_mmap);
+
+/**
+ * Frees all blocks. Can be called repeatedly.
+ *
+ * @param arr Array to free.
+ */
+void ssegarray_free(ssegarray * const arr);
+
+/**
+ * Appends a copy of the element, allocating a new block if the last one is
+ * full.
+ *
+ * @param arr Array to append to.
+ * @param element Pointer to the appended element or `NULL` to leave it
+ * uninitialized.
+ * @return Stable pointer to the stored element or `NULL` on allocation
+ * failure.
+ */
+void *ssegarray_push(ssegarray * const arr, const void * const element);
+
+/**
+ * Removes the last element. The blocks are kept for later pushes.
+ *
+ * @param arr Array to remove from.
+ * @param element Buffer for the removed element, can be `NULL`.
+ * @return `false` if the array is empty, `true` otherwise.
+ */
+bool ssegarray_pop(ssegarray * const arr, void * const element);
+
+/**
+ * Allocates blocks until the array can hold at least `capacity` elements.
+ *
+ * @param arr Array to reserve in.
+ * @param capacity Requested capacity in elements.
+ * @return `true` upon success, `false` otherwise.
+ */
+bool ssegarray_reserve(ssegarray * const arr, size_t const capacity);
+
+/**
+ * Frees the blocks which hold no elements.
+ *
+ * @param arr Array to shrink.
+ */
+void ssegarray_shrink_to_fit(ssegarray * const arr);
+
+/**
+ * Returns a pointer to the element at `index`. The index is not checked.
+ *
+ * @param arr Array to index.
+ * @param index Element index.
+ * @return Pointer to the element.
+ */
+void *ssegarray_at(ssegarray const * const arr, size_t const index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*INCLUDE_SSEGARRAY_H*/
+
+#ifdef SSEGARRAY_IMPLEMENTATION
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+/* anonymous mappings might need _DEFAULT_SOURCE or _GNU_SOURCE */
+#if defined(MAP_ANONYMOUS)
+#define SSEGARRAY__HAS_MMAP
+#define SSEGARRAY__MAP_ANONYMOUS MAP_ANONYMOUS
+#elif defined(MAP_ANON)
+#define SSEGARRAY__HAS_MMAP
+#define SSEGARRAY__MAP_ANONYMOUS MAP_ANON
+#else
+#warning "ssegarray: MAP_ANONYMOUS is hidden, define _DEFAULT_SOURCE or _GNU_SOURCE to allocate blocks with mmap()"
+#endif
+#endif
+
+static void *ssegarray__alloc_block(ssegarray const * const arr)
+{
+    size_t const size = arr->element_size << arr->block_shift;
+#ifdef SSEGARRAY__HAS_MMAP
+    if (arr->use_mmap)
+    {
+        void *block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | SSEGARRAY__MAP_ANONYMOUS, -1, 0);
+        return block == MAP_FAILED ? NULL : block;
+    }
+#endif
+    return SSEGARRAY_REALLOC(NULL, size);
+}
+
+static void ssegarray__free_block(ssegarray const * const arr, void * const block)
+{
+#ifdef SSEGARRAY__HAS_MMAP
+    if (arr->use_mmap)
+    {
+        munmap(block, arr->element_size << arr->block_shift);
+        return;
+    }
+#else
+    (void) arr;
+#endif
+    SSEGARRAY_FREE(block);
+}
+
+static bool ssegarray__add_block(ssegarray * const arr)
+{
+    if (arr->block_count == arr->blocks_capacity)
+    {
+        /* only the block directory is reallocated, the blocks stay in place */
+        size_t const new_capacity = arr->blocks_capacity ? 2 * arr->blocks_capacity : 8;
+        void **blocks = (void **) SSEGARRAY_REALLOC(arr->blocks, sizeof(void *) * new_capacity);
+        if (blocks == NULL)
+        {
+            return false;
+        }
+        arr->blocks = blocks;
+        arr->blocks_capacity = new_capacity;
+    }
+
+    void *block = ssegarray__alloc_block(arr);
+    if (block == NULL)
+    {
+        return false;
+    }
+    arr->blocks[arr->block_count++] = block;
+
+    return true;
+}
+
+ssegarray ssegarray_new(size_t const element_size, size_t const block_shift, bool const use_mmap)
+{
+    ssegarray arr = {.blocks = NULL,
+                     .block_count = 0,
+                     .blocks_capacity = 0,
+                     .length = 0,
+                     .element_size = element_size,
+                     .block_shift = block_shift,
+                     .use_mmap = use_mmap};
+#ifndef SSEGARRAY__HAS_MMAP
+    arr.use_mmap = false;
+#endif
+    return arr;
+}
+
+void ssegarray_free(ssegarray * const arr)
+{
+    for (size_t i = 0; i < arr->block_count; i++)
+    {
+        ssegarray__free_block(arr, arr->blocks[i]);
+    }
+    SSEGARRAY_FREE(arr->blocks);
+
+    arr->blocks = NULL;
+    arr->block_count = 0;
+    arr->blocks_capacity = 0;
+    arr->length = 0;
+}
+
+void *ssegarray_push(ssegarray * const arr, const void * const element)
+{
+    if (arr->length == arr->block_count << arr->block_shift && !ssegarray__add_block(arr))
+    {
+        return NULL;
+    }
+
+    void *at = ssegarray_at(arr, arr->length);
+    if (element != NULL)
+    {
+        memcpy(at, element, arr->element_size);
+    }
+    arr->length++;
+
+    return at;
+}
+
+bool ssegarray_pop(ssegarray * const arr, void * const element)
+{
+    if (arr->length == 0)
+    {
+        return false;
+    }
+
+    arr->length--;
+    if (element != NULL)
+    {
+        memcpy(element, ssegarray_at(arr, arr->length), arr->element_size);
+    }
+
+    return true;
+}
+
+bool ssegarray_reserve(ssegarray * const arr, size_t const capacity)
+{
+    while (arr->block_count << arr->block_shift < capacity)
+    {
+        if (!ssegarray__add_block(arr))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ssegarray_shrink_to_fit(ssegarray * const arr)
+{
+    size_t const mask = ((size_t) 1 << arr->block_shift) - 1;
+    size_t const used = (arr->length >> arr->block_shift) + ((arr->length & mask) != 0);
+
+    while (arr->block_count > used)
+    {
+        ssegarray__free_block(arr, arr->blocks[--arr->block_count]);
+    }
+}
+
+void *ssegarray_at(ssegarray const * const arr, size_t const index)
+{
+    size_t const mask = ((size_t) 1 << arr->block_shift) - 1;
+    return (void *) (((uint8_t *) arr->blocks[index >> arr->block_shift]) + (index & mask) * arr->element_size);
+}
+
+#endif /*SSEGARRAY_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
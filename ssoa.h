@@ -0,0 +1,350 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     #define SSOA_REALLOC(ptr,size) realloc(ptr,size)
+ *     #define SSOA_FREE(ptr)         free(ptr)
+ *
+ *         These defines only need to be set in the file containing
+ *         #define SSOA_IMPLEMENTATION.
+ *
+ *         By default, ssoa uses stdlib realloc() and free() for memory
+ *         management. You can substitute your own functions instead by defining
+ *         these symbols. You must either define both, or neither.
+ *
+ * Struct-of-arrays container. Every column is a separate contiguous array
+ * with its own element size and all columns share one length and capacity,
+ * so a loop over a single field touches only that field's memory.
+ */
+
+#ifndef INCLUDE_SSOA_H
+#define INCLUDE_SSOA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(SSOA_REALLOC) && !defined(SSOA_FREE) || !defined(SSOA_REALLOC) && defined(SSOA_FREE)
+#error "You must define both SSOA_REALLOC and SSOA_FREE, or neither."
+#endif
+#if !defined(SSOA_REALLOC) && !defined(SSOA_FREE)
+#include <stdlib.h>
+#define SSOA_REALLOC(ptr, size) realloc(ptr, size)
+#define SSOA_FREE(ptr) free(ptr)
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct
+{
+    void **columns;
+    size_t *element_sizes;
+    size_t column_count;
+    size_t length;
+    size_t capacity;
+} ssoa;
+
+/**
+ * Allocates a new struct-of-arrays container. You MUST check if the returned
+ * struct's .columns field is not `NULL`.
+ *
+ * @param element_sizes Element size of each column in bytes.
+ * @param column_count Number of columns.
+ * @param init_capacity Initial capacity of every column in elements.
+ * @return New container.
+ */
+ssoa ssoa_new(const size_t * const element_sizes, size_t const column_count, size_t const init_capacity);
+
+/**
+ * Frees all columns. Can be called repeatedly.
+ *
+ * @param soa Container to free.
+ */
+void ssoa_free(ssoa * const soa);
+
+/**
+ * Makes sure every column can hold at least `capacity` elements.
+ *
+ * @param soa Container to reserve in.
+ * @param capacity Requested capacity in elements.
+ * @return `true` upon success, `false` otherwise.
+ */
+bool ssoa_reserve(ssoa * const soa, size_t const capacity);
+
+/**
+ * Appends one row.
+ *
+ * @param soa Container to append to.
+ * @param values Array of `.column_count` pointers to the values of the new
+ * row. A `NULL` array or `NULL` pointer leaves the value uninitialized.
+ * @return `true` upon success, `false` otherwise.
+ */
+bool ssoa_push(ssoa * const soa, const void * const * const values);
+
+/**
+ * Removes the row at `index` keeping the order of the remaining rows.
+ *
+ * @param soa Container to remove from.
+ * @param index Row index.
+ * @return `false` if the index is out of range, `true` otherwise.
+ */
+bool ssoa_remove(ssoa * const soa, size_t const index);
+
+/**
+ * Removes the row at `index` in O(1) by moving the last row into its place.
+ *
+ * @param soa Container to remove from.
+ * @param index Row index.
+ * @return `false` if the index is out of range, `true` otherwise.
+ */
+bool ssoa_swap_remove(ssoa * const soa, size_t const index);
+
+/**
+ * Returns the contiguous array of the column. The pointer is invalidated when
+ * the container is reallocated.
+ *
+ * @param soa Container.
+ * @param column Column index.
+ * @return Pointer to the first element of the column.
+ */
+void *ssoa_column(ssoa const * const soa, size_t const column);
+
+/**
+ * Returns a pointer to a single value. The indices are not checked.
+ *
+ * @param soa Container.
+ * @param column Column index.
+ * @param index Row index.
+ * @return Pointer to the value.
+ */
+void *ssoa_at(ssoa const * const soa, size_t const column, size_t const index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*INCLUDE_SSOA_H*/
+
+#ifdef SSOA_IMPLEMENTATION
+
+static bool ssoa__set_capacity(ssoa * const soa, size_t const capacity)
+{
+    bool const shrinking = capacity < soa->capacity;
+
+    for (size_t c = 0; c < soa->column_count; c++)
+    {
+        void *column = SSOA_REALLOC(soa->columns[c], soa->element_sizes[c] * capacity);
+        if (column != NULL)
+        {
+            soa->columns[c] = column;
+        }
+        /* a column which failed to shrink is still large enough */
+        else if (!shrinking)
+        {
+            return false;
+        }
+    }
+    soa->capacity = capacity;
+
+    return true;
+}
+
+static void ssoa__shrink(ssoa * const soa)
+{
+    /* shrink to half of the capacity at quarter occupancy */
+    size_t new_capacity = soa->capacity;
+    while (new_capacity >= 8 && soa->length <= new_capacity / 4)
+    {
+        new_capacity /= 2;
+    }
+
+    if (new_capacity != soa->capacity)
+    {
+        ssoa__set_capacity(soa, new_capacity);
+    }
+}
+
+ssoa ssoa_new(const size_t * const element_sizes, size_t const column_count, size_t const init_capacity)
+{
+    ssoa soa = {.columns = NULL, .element_sizes = NULL, .column_count = 0, .length = 0, .capacity = 0};
+
+    soa.columns = (void **) SSOA_REALLOC(NULL, sizeof(void *) * column_count);
+    soa.element_sizes = (size_t *) SSOA_REALLOC(NULL, sizeof(size_t) * column_count);
+    if (soa.columns == NULL || soa.element_sizes == NULL)
+    {
+        SSOA_FREE(soa.columns);
+        SSOA_FREE(soa.element_sizes);
+        soa.columns = NULL;
+        soa.element_sizes = NULL;
+        return soa;
+    }
+
+    for (size_t c = 0; c < column_count; c++)
+    {
+        soa.columns[c] = NULL;
+        soa.element_sizes[c] = element_sizes[c];
+    }
+    soa.column_count = column_count;
+
+    if (init_capacity > 0 && !ssoa__set_capacity(&soa, init_capacity))
+    {
+        ssoa_free(&soa);
+    }
+
+    return soa;
+}
+
+void ssoa_free(ssoa * const soa)
+{
+    for (size_t c = 0; c < soa->column_count; c++)
+    {
+        SSOA_FREE(soa->columns[c]);
+    }
+    SSOA_FREE(soa->columns);
+    SSOA_FREE(soa->element_sizes);
+
+    soa->columns = NULL;
+    soa->element_sizes = NULL;
+    soa->column_count = 0;
+    soa->length = 0;
+    soa->capacity = 0;
+}
+
+bool ssoa_reserve(ssoa * const soa, size_t const capacity)
+{
+    if (capacity <= soa->capacity)
+    {
+        return true;
+    }
+
+    return ssoa__set_capacity(soa, capacity);
+}
+
+bool ssoa_push(ssoa * const soa, const void * const * const values)
+{
+    if (soa->length == soa->capacity)
+    {
+        size_t const new_length = soa->length + 1;
+        /* ceil(new_length * 1.5) */
+        if (!ssoa_reserve(soa, 3 * new_length / 2 + ((new_length % 2) != 0)))
+        {
+            return false;
+        }
+    }
+
+    for (size_t c = 0; values != NULL && c < soa->column_count; c++)
+    {
+        if (values[c] != NULL)
+        {
+            memcpy(ssoa_at(soa, c, soa->length), values[c], soa->element_sizes[c]);
+        }
+    }
+    soa->length++;
+
+    return true;
+}
+
+bool ssoa_remove(ssoa * const soa, size_t const index)
+{
+    if (index >= soa->length)
+    {
+        return false;
+    }
+
+    for (size_t c = 0; c < soa->column_count; c++)
+    {
+        size_t const element_size = soa->element_sizes[c];
+        uint8_t * const at = ((uint8_t *) soa->columns[c]) + index * element_size;
+        memmove(at, at + element_size, element_size * (soa->length - index - 1));
+    }
+    soa->length--;
+
+    ssoa__shrink(soa);
+
+    return true;
+}
+
+bool ssoa_swap_remove(ssoa * const soa, size_t const index)
+{
+    if (index >= soa->length)
+    {
+        return false;
+    }
+
+    soa->length--;
+    for (size_t c = 0; index != soa->length && c < soa->column_count; c++)
+    {
+        memcpy(ssoa_at(soa, c, index), ssoa_at(soa, c, soa->length), soa->element_sizes[c]);
+    }
+
+    ssoa__shrink(soa);
+
+    return true;
+}
+
+void *ssoa_column(ssoa const * const soa, size_t const column)
+{
+    return soa->columns[column];
+}
+
+void *ssoa_at(ssoa const * const soa, size_t const column, size_t const index)
+{
+    return (void *) (((uint8_t *) soa->columns[column]) + index * soa->element_sizes[column]);
+}
+
+#endif /*SSOA_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/
@@ -0,0 +1,473 @@
+/**
+ * LICENSE
+ *
+ *     This file is in the public domain and also 0BSD licensed.
+ *     See end of file for more information.
+ *
+ * Compile-time options
+ *
+ *     #define SULIST_MALLOC(size) malloc(size)
+ *     #define SULIST_FREE(ptr)    free(ptr)
+ *
+ *         These defines only need to be set in the file containing
+ *         #define SULIST_IMPLEMENTATION.
+ *
+ *         By default, sulist uses stdlib malloc() and free() for memory
+ *         management. You can substitute your own functions instead by defining
+ *         these symbols. You must either define both, or neither.
+ *
+ *     #define SULIST_NODE_SIZE 128
+ *
+ *         Size of one node in bytes including its header, two cache lines by
+ *         default. Every node holds at least 2 elements.
+ *
+ * Unrolled doubly-linked list. Every node stores a small array of elements, so
+ * a sequential traversal touches one node per several elements instead of one
+ * node per element.
+ */
+
+#ifndef INCLUDE_SULIST_H
+#define INCLUDE_SULIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(SULIST_MALLOC) && !defined(SULIST_FREE) || !defined(SULIST_MALLOC) && defined(SULIST_FREE)
+#error "You must define both SULIST_MALLOC and SULIST_FREE, or neither."
+#endif
+#if !defined(SULIST_MALLOC) && !defined(SULIST_FREE)
+#include <stdlib.h>
+#define SULIST_MALLOC(size) malloc(size)
+#define SULIST_FREE(ptr) free(ptr)
+#endif
+
+#if !defined(SULIST_NODE_SIZE)
+#define SULIST_NODE_SIZE 128
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Node header, the elements follow it in the same allocation.
+ */
+typedef struct sulist_node
+{
+    struct sulist_node *next;
+    struct sulist_node *prev;
+    size_t count;
+    /* keeps the elements after the header 16-byte aligned on 64-bit systems */
+    size_t padding;
+} sulist_node;
+
+typedef struct
+{
+    sulist_node *first;
+    sulist_node *last;
+    size_t length;
+    size_t element_size;
+    size_t node_capacity;
+} sulist;
+
+/**
+ * Position of an element, `.node == NULL` is the end of the list.
+ */
+typedef struct
+{
+    sulist_node *node;
+    size_t index;
+} sulist_iter;
+
+sulist sulist_new(size_t const element_size);
+void sulist_free(sulist * const l);
+bool sulist_push_back(sulist * const l, const void * const element);
+bool sulist_push_front(sulist * const l, const void * const element);
+bool sulist_pop_back(sulist * const l, void * const element);
+bool sulist_pop_front(sulist * const l, void * const element);
+
+/**
+ * Inserts an element before `it`, splitting the node if it's full.
+ *
+ * @param l List to insert into.
+ * @param it Position to insert before, the end iterator appends.
+ * @param element Inserted element.
+ * @param inserted Set to the position of the inserted element, can be `NULL`.
+ * @return `true` upon success, `false` on allocation failure.
+ */
+bool sulist_insert(sulist * const l, sulist_iter const it, const void * const element, sulist_iter * const inserted);
+
+/**
+ * Removes the element at `it`, merging the node with its successor when both
+ * are at most half full.
+ *
+ * @param l List to remove from.
+ * @param it Position of the removed element.
+ * @return Position of the element which followed the removed one.
+ */
+sulist_iter sulist_remove(sulist * const l, sulist_iter const it);
+
+sulist_iter sulist_begin(sulist * const l);
+void sulist_next(sulist_iter * const it);
+void *sulist_get(sulist const * const l, sulist_iter const it);
+
+/**
+ * Finds the element at `index`, skipping whole nodes.
+ *
+ * @param l List.
+ * @param index Element index.
+ * @return Position of the element or the end iterator.
+ */
+sulist_iter sulist_find(sulist * const l, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*INCLUDE_SULIST_H*/
+
+#ifdef SULIST_IMPLEMENTATION
+
+static uint8_t *sulist__elements(sulist_node * const node)
+{
+    return (uint8_t *) (node + 1);
+}
+
+static sulist_node *sulist__node_new(sulist * const l)
+{
+    sulist_node *node = (sulist_node *) SULIST_MALLOC(sizeof(sulist_node) + l->element_size * l->node_capacity);
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+    node->count = 0;
+
+    return node;
+}
+
+static void sulist__link_after(sulist * const l, sulist_node * const node, sulist_node * const new_node)
+{
+    new_node->prev = node;
+    if (node == NULL)
+    {
+        new_node->next = l->first;
+        l->first = new_node;
+    }
+    else
+    {
+        new_node->next = node->next;
+        node->next = new_node;
+    }
+
+    if (new_node->next == NULL)
+    {
+        l->last = new_node;
+    }
+    else
+    {
+        new_node->next->prev = new_node;
+    }
+}
+
+static void sulist__unlink(sulist * const l, sulist_node * const node)
+{
+    if (node->prev == NULL)
+    {
+        l->first = node->next;
+    }
+    else
+    {
+        node->prev->next = node->next;
+    }
+
+    if (node->next == NULL)
+    {
+        l->last = node->prev;
+    }
+    else
+    {
+        node->next->prev = node->prev;
+    }
+
+    SULIST_FREE(node);
+}
+
+sulist sulist_new(size_t const element_size)
+{
+    size_t node_capacity = (SULIST_NODE_SIZE - sizeof(sulist_node)) / element_size;
+    sulist l = {.first = NULL,
+                .last = NULL,
+                .length = 0,
+                .element_size = element_size,
+                .node_capacity = node_capacity < 2 ? 2 : node_capacity};
+    return l;
+}
+
+void sulist_free(sulist * const l)
+{
+    sulist_node *next = l->first;
+    while (next != NULL)
+    {
+        sulist_node *current = next;
+        next = current->next;
+        SULIST_FREE(current);
+    }
+
+    l->first = NULL;
+    l->last = NULL;
+    l->length = 0;
+}
+
+bool sulist_push_back(sulist * const l, const void * const element)
+{
+    sulist_iter const end = {.node = NULL, .index = 0};
+    return sulist_insert(l, end, element, NULL);
+}
+
+bool sulist_push_front(sulist * const l, const void * const element)
+{
+    sulist_node *node = l->first;
+    if (node == NULL || node->count == l->node_capacity)
+    {
+        if ((node = sulist__node_new(l)) == NULL)
+        {
+            return false;
+        }
+        sulist__link_after(l, NULL, node);
+    }
+
+    sulist_iter const it = {.node = node, .index = 0};
+    return sulist_insert(l, it, element, NULL);
+}
+
+bool sulist_pop_back(sulist * const l, void * const element)
+{
+    if (l->last == NULL)
+    {
+        return false;
+    }
+
+    sulist_node * const node = l->last;
+    node->count--;
+    l->length--;
+    if (element != NULL)
+    {
+        memcpy(element, sulist__elements(node) + node->count * l->element_size, l->element_size);
+    }
+
+    if (node->count == 0)
+    {
+        sulist__unlink(l, node);
+    }
+
+    return true;
+}
+
+bool sulist_pop_front(sulist * const l, void * const element)
+{
+    if (l->first == NULL)
+    {
+        return false;
+    }
+
+    if (element != NULL)
+    {
+        memcpy(element, sulist__elements(l->first), l->element_size);
+    }
+
+    sulist_node * const node = l->first;
+    node->count--;
+    l->length--;
+    if (node->count == 0)
+    {
+        sulist__unlink(l, node);
+    }
+    else
+    {
+        memmove(sulist__elements(node), sulist__elements(node) + l->element_size, node->count * l->element_size);
+    }
+
+    return true;
+}
+
+bool sulist_insert(sulist * const l, sulist_iter const it, const void * const element, sulist_iter * const inserted)
+{
+    size_t const es = l->element_size;
+    sulist_node *node = it.node;
+    size_t index = it.index;
+
+    /* append at the end of the last node */
+    if (node == NULL)
+    {
+        node = l->last;
+        if (node == NULL || node->count == l->node_capacity)
+        {
+            sulist_node * const new_node = sulist__node_new(l);
+            if (new_node == NULL)
+            {
+                return false;
+            }
+            sulist__link_after(l, l->last, new_node);
+            node = new_node;
+        }
+        index = node->count;
+    }
+    /* split a full node, moving the upper half to a new node */
+    else if (node->count == l->node_capacity)
+    {
+        sulist_node * const new_node = sulist__node_new(l);
+        if (new_node == NULL)
+        {
+            return false;
+        }
+        sulist__link_after(l, node, new_node);
+
+        size_t const half = node->count / 2;
+        new_node->count = node->count - half;
+        node->count = half;
+        memcpy(sulist__elements(new_node), sulist__elements(node) + half * es, new_node->count * es);
+
+        if (index > half)
+        {
+            node = new_node;
+            index -= half;
+        }
+    }
+
+    uint8_t * const at = sulist__elements(node) + index * es;
+    memmove(at + es, at, (node->count - index) * es);
+    memcpy(at, element, es);
+    node->count++;
+    l->length++;
+
+    if (inserted != NULL)
+    {
+        inserted->node = node;
+        inserted->index = index;
+    }
+
+    return true;
+}
+
+sulist_iter sulist_remove(sulist * const l, sulist_iter const it)
+{
+    size_t const es = l->element_size;
+    sulist_node * const node = it.node;
+    sulist_iter result = it;
+
+    uint8_t * const at = sulist__elements(node) + it.index * es;
+    memmove(at, at + es, (node->count - it.index - 1) * es);
+    node->count--;
+    l->length--;
+
+    if (node->count == 0)
+    {
+        result.node = node->next;
+        result.index = 0;
+        sulist__unlink(l, node);
+        return result;
+    }
+
+    sulist_node * const next = node->next;
+    if (next != NULL && node->count <= l->node_capacity / 2 && next->count <= l->node_capacity / 2)
+    {
+        memcpy(sulist__elements(node) + node->count * es, sulist__elements(next), next->count * es);
+        node->count += next->count;
+        sulist__unlink(l, next);
+    }
+
+    if (result.index == node->count)
+    {
+        result.node = node->next;
+        result.index = 0;
+    }
+
+    return result;
+}
+
+sulist_iter sulist_begin(sulist * const l)
+{
+    sulist_iter const it = {.node = l->first, .index = 0};
+    return it;
+}
+
+void sulist_next(sulist_iter * const it)
+{
+    if (++it->index >= it->node->count)
+    {
+        it->node = it->node->next;
+        it->index = 0;
+    }
+}
+
+void *sulist_get(sulist const * const l, sulist_iter const it)
+{
+    return (void *) (sulist__elements(it.node) + it.index * l->element_size);
+}
+
+sulist_iter sulist_find(sulist * const l, size_t index)
+{
+    sulist_iter it = {.node = l->first, .index = 0};
+    while (it.node != NULL && index >= it.node->count)
+    {
+        index -= it.node->count;
+        it.node = it.node->next;
+    }
+    it.index = it.node != NULL ? index : 0;
+    return it;
+}
+
+#endif /*SULIST_IMPLEMENTATION*/
+
+/*
+-------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+-------------------------------------------------------------------------------
+0BSD license:
+
+Copyright (c) 2026 Petr Kabelka
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+-------------------------------------------------------------------------------
+Public Domain (Unlicense):
+
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+-------------------------------------------------------------------------------
+*/